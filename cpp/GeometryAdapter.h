@@ -0,0 +1,27 @@
+#ifndef _GEOMETRYADAPTER_H
+#define _GEOMETRYADAPTER_H
+#pragma once
+
+#include <d2d1.h>
+
+#include <cstddef>
+#include <vector>
+
+#include "geometry/Point2D.h"
+
+// Conversions from the window's D2D1_ELLIPSE handles to the D2D-free geometry core.
+
+inline Geometry::Point2D ToPoint(const D2D1_ELLIPSE& ellipse) {
+	return Geometry::Point2D{ ellipse.point.x, ellipse.point.y };
+}
+
+inline std::vector<Geometry::Point2D> ToPoints(const std::vector<D2D1_ELLIPSE>& ellipses) {
+	std::vector<Geometry::Point2D> points;
+	points.reserve(ellipses.size());
+	for (size_t i = 0; i < ellipses.size(); i++) {
+		points.push_back(ToPoint(ellipses[i]));
+	}
+	return points;
+}
+
+#endif
@@ -0,0 +1,1391 @@
+// Micro benchmarks for the geometry core. Run it under perf/valgrind on Linux to look at the hot paths:
+//
+//     hullbench [max_points] [broadphase]
+//
+// Every row prints the best of a few repetitions, so a noisy machine mostly shows up as a slower first run.
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cmath>
+#include <cstring>
+#include <list>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "geometry/AklToussaint.h"
+#include "geometry/BatchHull.h"
+#include "geometry/Broadphase.h"
+#include "geometry/ChanHull.h"
+#include "geometry/ConvexHullLocator.h"
+#include "geometry/DynamicHull.h"
+#include "geometry/DynamicTree.h"
+#include "geometry/Epa.h"
+#include "geometry/Gjk.h"
+#include "geometry/GjkCache.h"
+#include "geometry/HullCache.h"
+#include "geometry/HullClassifier.h"
+#include "geometry/HullKernels.h"
+#include "geometry/HullMath.h"
+#include "geometry/MergeHull.h"
+#include "geometry/MonotoneChain.h"
+#include "geometry/PickIndex.h"
+#include "geometry/PointStore.h"
+#include "geometry/Predicates.h"
+#include "geometry/QuickHull.h"
+#include "geometry/SpatialHash.h"
+#include "geometry/SweepAndPrune.h"
+#include "geometry/SupportShape.h"
+#include "geometry/TaskPool.h"
+
+using Geometry::HullMath;
+using Geometry::Point2D;
+
+namespace {
+
+	// Uniform in a square: most points are interior and the hull stays small (O(log n)).
+	std::vector<Point2D> SquareCloud(size_t n, unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<double> coord(0.0, 1000.0);
+		std::vector<Point2D> points(n);
+		for (size_t i = 0; i < n; i++) {
+			points[i] = Point2D{ coord(rng), coord(rng) };
+		}
+		return points;
+	}
+
+	// Uniform in a disc: hulls grow like n^(1/3), which is harder on output sensitive code.
+	std::vector<Point2D> DiscCloud(size_t n, unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<double> unit(0.0, 1.0);
+		std::vector<Point2D> points(n);
+		for (size_t i = 0; i < n; i++) {
+			double r = 500.0 * std::sqrt(unit(rng));
+			double theta = 6.283185307179586 * unit(rng);
+			points[i] = Point2D{ 500.0 + r * std::cos(theta), 500.0 + r * std::sin(theta) };
+		}
+		return points;
+	}
+
+	// Points on a line, rounded to doubles: nearly every orientation test is too close to call in plain doubles.
+	std::vector<Point2D> LineCloud(size_t n, unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<double> unit(0.0, 1.0);
+		std::vector<Point2D> points(n);
+		for (size_t i = 0; i < n; i++) {
+			double t = unit(rng);
+			points[i] = Point2D{ 0.1 + 1000.0 * t, 0.3 + 300.0 * t };
+		}
+		return points;
+	}
+
+	template <typename F>
+	double BestOf(int reps, F&& work) {
+		double best = 1e300;
+		for (int r = 0; r < reps; r++) {
+			auto start = std::chrono::steady_clock::now();
+			work();
+			auto stop = std::chrono::steady_clock::now();
+			double ms = std::chrono::duration<double, std::milli>(stop - start).count();
+			if (ms < best) {
+				best = ms;
+			}
+		}
+		return best;
+	}
+
+	void Report(const char* name, size_t n, double ms, size_t result) {
+		std::printf("%-28s n=%-9zu %10.3f ms   result=%zu\n", name, n, ms, result);
+	}
+
+	std::vector<Point2D> SortedHull(const std::vector<Point2D>& points) {
+		return Geometry::MonotoneChain::GetConvexHull(points);
+	}
+
+	std::vector<Point2D> QuickHullOrdered(const std::vector<Point2D>& points) {
+		Geometry::QuickHull qhull(points);
+		return qhull.GetConvexHull();
+	}
+
+	void BenchHulls(size_t max_points) {
+		std::printf("-- convex hull --\n");
+		for (size_t n = 1000; n <= max_points; n *= 10) {
+			std::vector<Point2D> square = SquareCloud(n, 1);
+			std::vector<Point2D> disc = DiscCloud(n, 2);
+			size_t h = 0;
+
+			double ms = BestOf(3, [&]() { h = QuickHullOrdered(square).size(); });
+			Report("QuickHull square", n, ms, h);
+
+			ms = BestOf(3, [&]() { h = QuickHullOrdered(disc).size(); });
+			Report("QuickHull disc", n, ms, h);
+
+			ms = BestOf(3, [&]() { h = SortedHull(square).size(); });
+			Report("MonotoneChain square", n, ms, h);
+
+			ms = BestOf(3, [&]() { h = SortedHull(disc).size(); });
+			Report("MonotoneChain disc", n, ms, h);
+
+			ms = BestOf(3, [&]() { h = Geometry::ChanHull::GetConvexHull(square).size(); });
+			Report("ChanHull square", n, ms, h);
+
+			ms = BestOf(3, [&]() { h = Geometry::ChanHull::GetConvexHull(disc).size(); });
+			Report("ChanHull disc", n, ms, h);
+
+			ms = BestOf(3, [&]() { h = Geometry::MergeHull::GetConvexHull(square).size(); });
+			Report("MergeHull square", n, ms, h);
+
+			ms = BestOf(3, [&]() { h = Geometry::MergeHull::GetConvexHull(disc).size(); });
+			Report("MergeHull disc", n, ms, h);
+		}
+	}
+
+	// Parallel QuickHull and ChanHull from 1 to all hardware threads, on the biggest cloud.
+	void BenchParallelHull(size_t n) {
+		std::printf("-- parallel hull scaling --\n");
+		unsigned max_threads = std::thread::hardware_concurrency();
+		if (max_threads == 0) {
+			max_threads = 1;
+		}
+
+		std::vector<Point2D> disc = DiscCloud(n, 2);
+		std::vector<Point2D> serial = QuickHullOrdered(disc);
+		double serial_ms = BestOf(3, [&]() { QuickHullOrdered(disc); });
+		Report("QuickHull serial", n, serial_ms, serial.size());
+
+		for (unsigned threads = 1;; threads = threads * 2 < max_threads ? threads * 2 : max_threads) {
+			Geometry::TaskPool pool(threads);
+			Geometry::QuickHull qhull(disc);
+			std::vector<Point2D> parallel;
+			double ms = BestOf(3, [&]() { parallel = qhull.GetConvexHull(pool); });
+
+			char name[64];
+			std::snprintf(name, sizeof(name), "QuickHull %u threads", threads);
+			Report(name, n, ms, parallel.size());
+			std::printf("%-28s speedup %.2fx, %s\n", "", serial_ms / ms, parallel == serial ? "same hull" : "HULL DIFFERS");
+
+			ms = BestOf(3, [&]() { parallel = Geometry::ChanHull::GetConvexHull(disc, pool); });
+			std::snprintf(name, sizeof(name), "ChanHull %u threads", threads);
+			Report(name, n, ms, parallel.size());
+			std::printf("%-28s %s\n", "", parallel == serial ? "same hull" : "HULL DIFFERS");
+
+			ms = BestOf(3, [&]() { parallel = Geometry::MergeHull::GetConvexHull(disc, pool); });
+			std::snprintf(name, sizeof(name), "MergeHull %u threads", threads);
+			Report(name, n, ms, parallel.size());
+			std::printf("%-28s %s\n", "", parallel == serial ? "same hull" : "HULL DIFFERS");
+			if (threads == max_threads) {
+				break;
+			}
+		}
+	}
+
+	// Regular polygon with n vertices around (cx, cy); every vertex is on the hull.
+	std::vector<Point2D> Polygon(size_t n, double cx, double cy) {
+		std::vector<Point2D> points(n);
+		for (size_t i = 0; i < n; i++) {
+			double theta = 6.283185307179586 * i / n;
+			points[i] = Point2D{ cx + 500.0 * std::cos(theta), cy + 500.0 * std::sin(theta) };
+		}
+		return points;
+	}
+
+	// Hull of two big hulls: MergeHull::Merge against MonotoneChain over all their vertices.
+	void BenchHullMerge(size_t max_points) {
+		std::printf("-- hull merge --\n");
+		for (size_t n = 1000; n <= max_points; n *= 10) {
+			const char* names[] = { "apart", "overlap" };
+			double offsets[] = { 1500.0, 300.0 };
+			for (int c = 0; c < 2; c++) {
+				std::vector<Point2D> a = SortedHull(Polygon(n, 0.0, 0.0));
+				std::vector<Point2D> b = SortedHull(Polygon(n, offsets[c], 100.0));
+				std::vector<Point2D> both(a);
+				both.insert(both.end(), b.begin(), b.end());
+				std::vector<Point2D> reference = SortedHull(both);
+
+				char name[64];
+				std::vector<Point2D> hull;
+				double ms = BestOf(5, [&]() { hull = SortedHull(both); });
+				std::snprintf(name, sizeof(name), "MonotoneChain %s", names[c]);
+				Report(name, n, ms, hull.size());
+
+				ms = BestOf(5, [&]() { hull = Geometry::MergeHull::Merge(a, b); });
+				std::snprintf(name, sizeof(name), "Merge %s", names[c]);
+				Report(name, n, ms, hull.size());
+				std::printf("%-28s %s\n", "", hull == reference ? "same hull" : "HULL DIFFERS");
+			}
+		}
+	}
+
+	// How much the octagon pre-filter throws away on each distribution, and what that buys both engines.
+	void BenchPrefilter(size_t max_points) {
+		std::printf("-- akl-toussaint pre-filter --\n");
+		for (size_t n = 1000; n <= max_points; n *= 10) {
+			const char* names[] = { "square", "disc" };
+			std::vector<Point2D> clouds[] = { SquareCloud(n, 1), DiscCloud(n, 2) };
+			for (int c = 0; c < 2; c++) {
+				const std::vector<Point2D>& cloud = clouds[c];
+				std::vector<Point2D> reference = SortedHull(cloud);
+				char name[64];
+
+				size_t culled = 0;
+				double ms = BestOf(3, [&]() { Geometry::AklToussaint::Filter(cloud, culled); });
+				std::snprintf(name, sizeof(name), "Octagon filter %s", names[c]);
+				Report(name, n, ms, n - culled);
+				std::printf("%-28s culled %zu of %zu (%.1f%%)\n", "", culled, n, 100.0 * culled / n);
+
+				std::vector<Point2D> hull;
+				Geometry::QuickHull qhull(cloud);
+				qhull.prefilter = true;
+				ms = BestOf(3, [&]() { hull = qhull.GetConvexHull(); });
+				std::snprintf(name, sizeof(name), "QuickHull+filter %s", names[c]);
+				Report(name, n, ms, hull.size());
+				std::printf("%-28s %s\n", "", hull == reference ? "same hull" : "HULL DIFFERS");
+
+				ms = BestOf(3, [&]() { hull = SortedHull(Geometry::AklToussaint::Filter(cloud, culled)); });
+				std::snprintf(name, sizeof(name), "MonotoneChain+filter %s", names[c]);
+				Report(name, n, ms, hull.size());
+				std::printf("%-28s %s\n", "", hull == reference ? "same hull" : "HULL DIFFERS");
+			}
+		}
+	}
+
+	/* The farthest-point kernel on its own and QuickHull on top of it, for every ISA this CPU has.
+	All of them must agree with each other; the scalar kernel is the reference.
+	*/
+	void BenchKernels(size_t n) {
+		using Geometry::HullKernels;
+		std::printf("-- edge scan kernel (%s detected) --\n", HullKernels::Name(HullKernels::Detect()));
+
+		std::vector<Point2D> disc = DiscCloud(n, 2);
+		std::vector<double> xs(n), ys(n);
+		for (size_t i = 0; i < n; i++) {
+			xs[i] = disc[i].x;
+			ys[i] = disc[i].y;
+		}
+		const Point2D p1 = { 0.0, 300.0 };
+		const Point2D p2 = { 1000.0, 700.0 };
+
+		HullKernels::Select(HullKernels::Scalar);
+		HullKernels::EdgeScan reference = HullKernels::ScanEdge(xs.data(), ys.data(), n, p1, p2);
+		std::vector<Point2D> reference_hull = QuickHullOrdered(disc);
+
+		const HullKernels::Isa isas[] = { HullKernels::Scalar, HullKernels::Sse2, HullKernels::Avx2 };
+		for (HullKernels::Isa isa : isas) {
+			if (isa > HullKernels::Detect()) {
+				break;
+			}
+			HullKernels::Select(isa);
+			char name[64];
+
+			HullKernels::EdgeScan scan = {};
+			double ms = BestOf(5, [&]() { scan = HullKernels::ScanEdge(xs.data(), ys.data(), n, p1, p2); });
+			std::snprintf(name, sizeof(name), "ScanEdge %s", HullKernels::Name(isa));
+			Report(name, n, ms, scan.outside);
+			std::printf("%-28s %.0f Mpoints/s, %s\n", "", n / ms / 1000.0,
+				scan.farthest == reference.farthest && scan.outside == reference.outside ? "same scan" : "SCAN DIFFERS");
+
+			std::vector<Point2D> hull;
+			ms = BestOf(3, [&]() { hull = QuickHullOrdered(disc); });
+			std::snprintf(name, sizeof(name), "QuickHull %s", HullKernels::Name(isa));
+			Report(name, n, ms, hull.size());
+			std::printf("%-28s %s\n", "", hull == reference_hull ? "same hull" : "HULL DIFFERS");
+		}
+		HullKernels::Select(HullKernels::Detect());
+	}
+
+	/* Dragging points around a big scene: a DynamicHull update plus reading the hull back, against recomputing
+	the whole hull after every mouse move (only a few of those, they are slow).
+	*/
+	void BenchDynamicHull(size_t max_points) {
+		std::printf("-- dynamic hull (drag points) --\n");
+		const int moves = 1000;
+		const int rebuilds = 10;
+		for (size_t n = 1000; n <= max_points; n *= 10) {
+			std::vector<Point2D> disc = DiscCloud(n, 7);
+			std::vector<Point2D> targets = DiscCloud(moves, 8);
+			size_t h = 0;
+
+			double ms = BestOf(1, [&]() {
+				Geometry::DynamicHull inserted;
+				for (size_t i = 0; i < n; i++) {
+					inserted.Insert(disc[i]);
+				}
+				h = inserted.Hull().size();
+			});
+			Report("DynamicHull insert all", n, ms, h);
+
+			ms = BestOf(3, [&]() { h = Geometry::DynamicHull(disc).Hull().size(); });
+			Report("DynamicHull bulk build", n, ms, h);
+
+			// Slot i is disc[i].
+			Geometry::DynamicHull dynamic(disc);
+
+			ms = BestOf(1, [&]() {
+				for (int m = 0; m < moves; m++) {
+					dynamic.Move(dynamic.AtSlot((uint32_t)(m % n)), targets[m]);
+					h = dynamic.Hull().size();
+				}
+			});
+			Report("DynamicHull move x1000", n, ms, h);
+
+			std::vector<Point2D> moved = disc;
+			ms = BestOf(1, [&]() {
+				for (int m = 0; m < rebuilds; m++) {
+					moved[m % n] = targets[m];
+					h = SortedHull(moved).size();
+				}
+			});
+			Report("MonotoneChain rebuild x10", n, ms, h);
+
+			for (int m = 0; m < moves; m++) {
+				moved[m % n] = targets[m];
+			}
+			Geometry::DynamicHull::View view = dynamic.Hull();
+			std::vector<Point2D> dynamic_hull(view.begin(), view.end());
+			std::printf("%-28s %s\n", "", dynamic_hull == SortedHull(moved) ? "same hull" : "HULL DIFFERS");
+		}
+	}
+
+	/* Every engine on a well spread cloud and on a nearly collinear one, with how often the predicates had to
+	leave the double filter. On the disc that should be close to never; on the line it is most of the tests.
+	Call counting is on here, so the times run a little above the ones in the other sections.
+	*/
+	void BenchPredicates(size_t n) {
+		using Geometry::Predicates;
+		std::printf("-- exact predicates (slow path share) --\n");
+		Predicates::CountCalls(true);
+		const char* names[] = { "disc", "line" };
+		std::vector<Point2D> clouds[] = { DiscCloud(n, 2), LineCloud(n, 9) };
+		for (int c = 0; c < 2; c++) {
+			const std::vector<Point2D>& cloud = clouds[c];
+			std::vector<Point2D> reference = SortedHull(cloud);
+			const char* engines[] = { "MonotoneChain", "QuickHull", "ChanHull", "DynamicHull" };
+			for (int e = 0; e < 4; e++) {
+				std::vector<Point2D> hull;
+				Predicates::ResetTotals();
+				double ms = BestOf(1, [&]() {
+					switch (e) {
+					case 0:
+						hull = SortedHull(cloud);
+						break;
+					case 1:
+						hull = QuickHullOrdered(cloud);
+						break;
+					case 2:
+						hull = Geometry::ChanHull::GetConvexHull(cloud);
+						break;
+					default: {
+						Geometry::DynamicHull dynamic(cloud);
+						Geometry::DynamicHull::View view = dynamic.Hull();
+						hull.assign(view.begin(), view.end());
+					}
+					}
+				});
+				Predicates::Stats stats = Predicates::Totals();
+
+				char name[64];
+				std::snprintf(name, sizeof(name), "%s %s", engines[e], names[c]);
+				Report(name, n, ms, hull.size());
+				std::printf("%-28s orient %llu, exact %llu (%.3f%%); crossing %llu, exact %llu; %s\n", "",
+					(unsigned long long)stats.orient, (unsigned long long)stats.orient_exact,
+					stats.orient ? 100.0 * stats.orient_exact / stats.orient : 0.0,
+					(unsigned long long)stats.crossing, (unsigned long long)stats.crossing_exact,
+					hull == reference ? "same hull" : "HULL DIFFERS");
+			}
+		}
+		Predicates::CountCalls(false);
+	}
+
+	/* One tick of a game server: thousands of units, 4 to 16 points each, all hulled at once. Packed into one
+	buffer with offsets for BatchHull; the per-hull rows build a vector (or a QuickHull) per unit, like OnPaint.
+	*/
+	void BenchBatchHull() {
+		using Geometry::HullKernels;
+		const size_t sets = 10000;
+		std::printf("-- batched small hulls (%zu sets of 4-16 points) --\n", sets);
+
+		std::mt19937 rng(11);
+		std::uniform_int_distribution<size_t> size(4, 16);
+		std::uniform_real_distribution<double> coord(0.0, 1000.0);
+		std::uniform_real_distribution<double> offset(-20.0, 20.0);
+		std::vector<Point2D> points;
+		std::vector<size_t> offsets(1, 0);
+		std::vector<std::vector<Point2D>> units(sets);
+		for (size_t s = 0; s < sets; s++) {
+			Point2D center = { coord(rng), coord(rng) };
+			size_t n = size(rng);
+			for (size_t k = 0; k < n; k++) {
+				units[s].push_back(Point2D{ center.x + offset(rng), center.y + offset(rng) });
+			}
+			points.insert(points.end(), units[s].begin(), units[s].end());
+			offsets.push_back(points.size());
+		}
+
+		std::vector<Point2D> reference;
+		std::vector<size_t> reference_offsets(1, 0);
+		double ms = BestOf(5, [&]() {
+			reference.clear();
+			reference_offsets.resize(1);
+			for (size_t s = 0; s < sets; s++) {
+				std::vector<Point2D> hull = SortedHull(units[s]);
+				reference.insert(reference.end(), hull.begin(), hull.end());
+				reference_offsets.push_back(reference.size());
+			}
+		});
+		Report("MonotoneChain per set", points.size(), ms, reference.size());
+
+		size_t h = 0;
+		ms = BestOf(5, [&]() {
+			h = 0;
+			for (size_t s = 0; s < sets; s++) {
+				h += QuickHullOrdered(units[s]).size();
+			}
+		});
+		Report("QuickHull per set", points.size(), ms, h);
+
+		const HullKernels::Isa isas[] = { HullKernels::Scalar, HullKernels::Sse2, HullKernels::Avx2 };
+		for (HullKernels::Isa isa : isas) {
+			if (isa > HullKernels::Detect()) {
+				break;
+			}
+			HullKernels::Select(isa);
+			std::vector<Point2D> hulls;
+			std::vector<size_t> hull_offsets;
+			ms = BestOf(5, [&]() { Geometry::BatchHull::GetConvexHulls(points, offsets, hulls, hull_offsets); });
+			char name[64];
+			std::snprintf(name, sizeof(name), "BatchHull %s", HullKernels::Name(isa));
+			Report(name, points.size(), ms, hulls.size());
+			std::printf("%-28s %.0f ns/hull, %s\n", "", ms * 1e6 / sets,
+				hulls == reference && hull_offsets == reference_offsets ? "same hulls" : "HULLS DIFFER");
+		}
+		HullKernels::Select(HullKernels::Detect());
+	}
+
+	/* The window's paint loop: two 5-point hulls, their Minkowski difference and an overlap test every frame,
+	with an edit in one frame out of a hundred. Rebuilding everything every frame against the HullCache.
+	*/
+	void BenchHullCache() {
+		std::printf("-- hull cache (paint loop, 1 edit per 100 frames) --\n");
+		const int frames = 10000;
+		std::vector<Point2D> first = SquareCloud(5, 12);
+		std::vector<Point2D> second = SquareCloud(5, 13);
+		size_t h = 0;
+
+		double ms = BestOf(3, [&]() {
+			for (int f = 0; f < frames; f++) {
+				std::vector<Point2D> a = SortedHull(first);
+				std::vector<Point2D> b = SortedHull(second);
+				h = SortedHull(HullMath::MinkowskiDiff(a, b)).size() + (HullMath::HullsIntersecting(a, b) ? 1 : 0);
+			}
+		});
+		Report("rebuild every frame", frames, ms, h);
+
+		Geometry::HullCache cache;
+		Geometry::HullCache::Input first_input = cache.AddInput();
+		Geometry::HullCache::Input second_input = cache.AddInput();
+		Geometry::HullCache::Entry first_entry = cache.AddEntry({ first_input });
+		Geometry::HullCache::Entry second_entry = cache.AddEntry({ second_input });
+		Geometry::HullCache::Entry diff_entry = cache.AddEntry({ first_input, second_input });
+		Geometry::HullCache::Entry touching_entry = cache.AddEntry({ first_input, second_input });
+		bool touching = false;
+
+		ms = BestOf(3, [&]() {
+			cache.ResetStats();
+			for (int f = 0; f < frames; f++) {
+				if (f % 100 == 0) {
+					first[0].x += 1;
+					cache.Touch(first_input);
+				}
+				const std::vector<Point2D>& a = cache.Get(first_entry, [&](std::vector<Point2D>& hull) { hull = SortedHull(first); });
+				const std::vector<Point2D>& b = cache.Get(second_entry, [&](std::vector<Point2D>& hull) { hull = SortedHull(second); });
+				const std::vector<Point2D>& diff = cache.Get(diff_entry, [&](std::vector<Point2D>& hull) { hull = SortedHull(HullMath::MinkowskiDiff(a, b)); });
+				if (cache.Refresh(touching_entry)) {
+					touching = HullMath::HullsIntersecting(a, b);
+				}
+				h = diff.size() + (touching ? 1 : 0);
+				cache.EndFrame();
+			}
+		});
+		Report("HullCache", frames, ms, h);
+		const Geometry::HullCache::Stats& stats = cache.Totals();
+		std::printf("%-28s %.1f%% hits, %llu of %llu frames rebuilt nothing\n", "", 100.0 * cache.HitRate(),
+			(unsigned long long)stats.idle_frames, (unsigned long long)stats.frames);
+	}
+
+	// Pairwise cloud + hull against the edge merge, which needs no hull pass at all.
+	void BenchMinkowski() {
+		std::printf("-- minkowski --\n");
+		for (size_t k = 8; k <= 256; k *= 2) {
+			std::vector<Point2D> a = SortedHull(DiscCloud(k * 64, 3));
+			std::vector<Point2D> b = SortedHull(DiscCloud(k * 64, 4));
+			std::vector<Point2D> sum = SortedHull(HullMath::MinkowskiSum(a, b));
+			std::vector<Point2D> diff = SortedHull(HullMath::MinkowskiDiff(a, b));
+			std::vector<Point2D> out(a.size() + b.size());
+			size_t h = 0;
+
+			double ms = BestOf(3, [&]() { h = SortedHull(HullMath::MinkowskiSum(a, b)).size(); });
+			Report("MinkowskiSum", a.size() + b.size(), ms, h);
+
+			ms = BestOf(3, [&]() { h = SortedHull(HullMath::MinkowskiDiff(a, b)).size(); });
+			Report("MinkowskiDiff", a.size() + b.size(), ms, h);
+
+			std::vector<Point2D> merged;
+			ms = BestOf(3, [&]() { merged = HullMath::ConvexMinkowskiSum(a, b); });
+			Report("ConvexMinkowskiSum", a.size() + b.size(), ms, merged.size());
+			std::printf("%-28s %s\n", "", merged == sum ? "same hull" : "HULL DIFFERS");
+
+			ms = BestOf(3, [&]() { merged = HullMath::ConvexMinkowskiDiff(a, b); });
+			Report("ConvexMinkowskiDiff", a.size() + b.size(), ms, merged.size());
+			std::printf("%-28s %s\n", "", merged == diff ? "same hull" : "HULL DIFFERS");
+
+			ms = BestOf(3, [&]() { h = HullMath::ConvexMinkowskiDiff(a.data(), a.size(), b.data(), b.size(), out.data()); });
+			Report("ConvexMinkowskiDiff buffer", a.size() + b.size(), ms, h);
+
+			// What a collision query asks of the lazy difference instead: a handful of support points.
+			Geometry::PolygonShape shape_a(a);
+			Geometry::PolygonShape shape_b(b);
+			Geometry::MinkowskiDifferenceShape lazy(shape_a, shape_b);
+			double checksum = 0;
+			ms = BestOf(3, [&]() {
+				for (int d = 0; d < 16; d++) {
+					double theta = 6.283185307179586 * d / 16;
+					checksum += lazy.Support(Point2D{ std::cos(theta), std::sin(theta) }).x;
+				}
+			});
+			Report("Lazy diff, 16 supports", a.size() + b.size(), ms, checksum != 0 ? 16 : 0);
+		}
+	}
+
+	/* A million points against 8 hulls scattered over the square, all of 8 vertices and then all of 64:
+	ContainsPoint and a locator per hull one point at a time, then HullClassifier for every ISA, then on all
+	threads. The half-planes cost a point inside a hull's bounds every edge, where the locators take log n
+	steps, so the bigger hulls are the harder case. The points are in random order, so the classifier's chunk
+	bounds never help; sorted by cell they would.
+	*/
+	void BenchClassify() {
+		using Geometry::HullKernels;
+		std::printf("-- point in hulls, batched --\n");
+		const size_t n = 1 << 20;
+		std::vector<Point2D> points = SquareCloud(n, 7);
+		std::vector<double> x(n);
+		std::vector<double> y(n);
+		for (size_t i = 0; i < n; i++) {
+			x[i] = points[i].x;
+			y[i] = points[i].y;
+		}
+		for (size_t corners = 8; corners <= 64; corners *= 8) {
+			std::mt19937 rng(8);
+			std::uniform_real_distribution<double> unit(0.0, 1.0);
+			std::vector<std::vector<Point2D>> hulls;
+			std::vector<Geometry::ConvexHullLocator> locators;
+			for (size_t h = 0; h < 8; h++) {
+				std::vector<Point2D> polygon = Polygon(corners, 0, 0);
+				double scale = 0.1 + 0.2 * unit(rng);
+				Point2D center = { 150 + 700 * unit(rng), 150 + 700 * unit(rng) };
+				for (Point2D& point : polygon) {
+					point = center + scale * point;
+				}
+				hulls.push_back(SortedHull(polygon));
+				locators.emplace_back(hulls.back());
+			}
+			std::printf("%-28s %zu hulls of %zu vertices\n", "", hulls.size(), corners);
+
+			size_t reference = 0;
+			double ms = BestOf(3, [&]() {
+				reference = 0;
+				for (size_t i = 0; i < n; i++) {
+					for (size_t h = 0; h < hulls.size(); h++) {
+						if (HullMath::ContainsPoint(hulls[h], points[i])) {
+							reference++;
+							break;
+						}
+					}
+				}
+			});
+			Report("ContainsPoint per point", n, ms, reference);
+
+			size_t found = 0;
+			ms = BestOf(3, [&]() {
+				found = 0;
+				for (size_t i = 0; i < n; i++) {
+					for (const Geometry::ConvexHullLocator& locator : locators) {
+						if (locator.Contains(points[i])) {
+							found++;
+							break;
+						}
+					}
+				}
+			});
+			Report("Locators per point", n, ms, found);
+
+			Geometry::HullClassifier classifier(hulls);
+			std::vector<int32_t> ids(n);
+			auto count = [&]() {
+				size_t inside = 0;
+				for (int32_t id : ids) {
+					inside += id != Geometry::HullClassifier::NoHull ? 1 : 0;
+				}
+				return inside;
+			};
+			bool same = found == reference;
+			for (int isa = HullKernels::Scalar; isa <= HullKernels::Detect(); isa++) {
+				HullKernels::Select((HullKernels::Isa)isa);
+				ms = BestOf(3, [&]() { classifier.Locate(x.data(), y.data(), n, ids.data()); });
+				char name[64];
+				std::snprintf(name, sizeof(name), "HullClassifier %s", HullKernels::Name((HullKernels::Isa)isa));
+				Report(name, n, ms, count());
+				same = same && count() == reference;
+			}
+			HullKernels::Select(HullKernels::Detect());
+
+			Geometry::TaskPool& pool = Geometry::TaskPool::Default();
+			ms = BestOf(3, [&]() { classifier.Locate(x.data(), y.data(), n, ids.data(), pool); });
+			char name[64];
+			std::snprintf(name, sizeof(name), "HullClassifier %u threads", pool.ThreadCount());
+			Report(name, n, ms, count());
+			same = same && count() == reference;
+			std::printf("%-28s %.0f Mpoints/s, %s\n", "", n / ms / 1000.0, same ? "same answers" : "ANSWERS DIFFER");
+		}
+	}
+
+	/* Clicking on one of 50000 editor handles (circles of radius 10): the window's old reverse walk over all
+	of them, testing each like MyEllipse::HitTest does, against the pick index. Then dragging: every handle
+	nudged once, which mostly stays inside its cells.
+	*/
+	void BenchPicking() {
+		std::printf("-- picking handles --\n");
+		const size_t n = 50000;
+		const size_t clicks = 10000;
+		const float radius = 10.0f;
+		std::vector<Point2D> handles = SquareCloud(n, 9);
+		for (Point2D& handle : handles) {
+			handle = 4.0 * handle;
+		}
+		std::vector<Point2D> targets = SquareCloud(clicks, 10);
+		for (size_t i = 0; i < clicks; i += 2) {
+			targets[i] = handles[(i * 7919) % n] + Point2D{ 3, -4 };
+		}
+		for (size_t i = 1; i < clicks; i += 2) {
+			targets[i] = 4.0 * targets[i];
+		}
+
+		size_t reference = 0;
+		double ms = BestOf(3, [&]() {
+			reference = 0;
+			for (const Point2D& target : targets) {
+				for (size_t i = n; i-- > 0;) {
+					const float x1 = (float)target.x - (float)handles[i].x;
+					const float y1 = (float)target.y - (float)handles[i].y;
+					if ((x1 * x1) / (radius * radius) + (y1 * y1) / (radius * radius) <= 1.0f) {
+						reference += i + 1;
+						break;
+					}
+				}
+			}
+		});
+		Report("Reverse walk", clicks, ms, reference);
+
+		Geometry::PickIndex index;
+		ms = BestOf(3, [&]() {
+			index.Clear();
+			for (size_t i = 0; i < n; i++) {
+				index.Insert((Geometry::PickIndex::Id)i, handles[i], radius);
+			}
+		});
+		Report("PickIndex insert", n, ms, index.Cells());
+
+		size_t found = 0;
+		ms = BestOf(3, [&]() {
+			found = 0;
+			for (const Point2D& target : targets) {
+				Geometry::PickIndex::Id id = index.Pick(target);
+				found += id == Geometry::PickIndex::None ? 0 : id + 1;
+			}
+		});
+		Report("PickIndex", clicks, ms, found);
+		std::printf("%-28s %s\n", "", found == reference ? "same picks" : "PICKS DIFFER");
+
+		std::mt19937 rng(11);
+		std::uniform_real_distribution<double> step(-3.0, 3.0);
+		ms = BestOf(3, [&]() {
+			for (size_t i = 0; i < n; i++) {
+				handles[i] = handles[i] + Point2D{ step(rng), step(rng) };
+				index.Move((Geometry::PickIndex::Id)i, handles[i]);
+			}
+		});
+		Report("PickIndex move", n, ms, index.Size());
+	}
+
+	/* The window's handles as it used to keep them, a list of shared_ptrs to ellipses, against a PointStore. A
+	pass over all of them (their bounds, like hull picking takes), then which of a few hulls each is in: the list
+	has to be copied out into arrays for HullClassifier first, the store is read as it is.
+	*/
+	void BenchPointStore() {
+		struct Ellipse {
+			float x, y, radius_x, radius_y;
+			float color[4];
+		};
+		std::printf("-- handle storage --\n");
+		const size_t n = 50000;
+		std::vector<Point2D> points = SquareCloud(n, 12);
+		std::list<std::shared_ptr<Ellipse>> ellipses;
+		Geometry::PointStore store;
+		for (const Point2D& point : points) {
+			ellipses.push_back(std::make_shared<Ellipse>(Ellipse{ (float)point.x, (float)point.y, 10, 10, { 1, 1, 0, 1 } }));
+			store.Insert(Point2D{ (float)point.x, (float)point.y }, 10, 0xFFFF00);
+		}
+
+		Geometry::Aabb box = {};
+		double ms = BestOf(5, [&]() {
+			box = Geometry::Aabb{ Point2D{ INFINITY, INFINITY }, Point2D{ -INFINITY, -INFINITY } };
+			for (const std::shared_ptr<Ellipse>& ellipse : ellipses) {
+				Point2D point = { ellipse->x, ellipse->y };
+				box = Geometry::Union(box, Geometry::Aabb{ point, point });
+			}
+		});
+		Report("Bounds, list", n, ms, (size_t)(box.max.x - box.min.x));
+		ms = BestOf(5, [&]() { box = Geometry::BoundsOf(store.X(), store.Y(), store.Size()); });
+		Report("Bounds, store", n, ms, (size_t)(box.max.x - box.min.x));
+
+		std::vector<std::vector<Point2D>> hulls;
+		for (size_t h = 0; h < 4; h++) {
+			std::vector<Point2D> polygon = Polygon(16, 0, 0);
+			for (Point2D& point : polygon) {
+				point = Point2D{ 200 + 200 * (double)h, 500 } + 0.15 * point;
+			}
+			hulls.push_back(SortedHull(polygon));
+		}
+		Geometry::HullClassifier classifier(hulls);
+		std::vector<int32_t> ids(n);
+		auto inside = [&]() {
+			size_t count = 0;
+			for (int32_t id : ids) {
+				count += id != Geometry::HullClassifier::NoHull ? 1 : 0;
+			}
+			return count;
+		};
+		std::vector<double> x(n);
+		std::vector<double> y(n);
+		ms = BestOf(5, [&]() {
+			size_t i = 0;
+			for (const std::shared_ptr<Ellipse>& ellipse : ellipses) {
+				x[i] = ellipse->x;
+				y[i] = ellipse->y;
+				i++;
+			}
+			classifier.Locate(x.data(), y.data(), n, ids.data());
+		});
+		size_t reference = inside();
+		Report("Classify, list copied", n, ms, reference);
+		ms = BestOf(5, [&]() { classifier.Locate(store.X(), store.Y(), store.Size(), ids.data()); });
+		Report("Classify, store", n, ms, inside());
+		std::printf("%-28s %s\n", "", inside() == reference ? "same answers" : "ANSWERS DIFFER");
+	}
+
+	// What ContainsPoint used to do: a ray to x = 10000 against every edge, O(n). Kept to compare.
+	bool RayCastContains(const std::vector<Point2D>& hull, const Point2D& point) {
+		Point2D extreme = Point2D{ 10000, point.y };
+		int crossings = 0;
+		for (size_t i = 0; i < hull.size(); i++) {
+			size_t next = (i + 1) % hull.size();
+			if (HullMath::LineIntersects(hull[i], hull[next], point, extreme)) {
+				if (HullMath::PointOri(hull[i], point, hull[next]) == 0) {
+					return HullMath::onLine(hull[i], point, hull[next]);
+				}
+				crossings++;
+			}
+		}
+		return crossings % 2 == 1;
+	}
+
+	// Point in hull on hulls from 16 to 65536 vertices: the old ray cast, the wedge search and the locator.
+	void BenchContainment() {
+		std::printf("-- point in hull by size --\n");
+		std::vector<Point2D> queries = SquareCloud(100000, 5);
+		for (size_t n = 16; n <= 65536; n *= 16) {
+			std::vector<Point2D> hull = SortedHull(Polygon(n, 500.0, 500.0));
+			size_t reference = 0;
+			size_t inside = 0;
+			double ms = BestOf(3, [&]() {
+				reference = 0;
+				for (size_t i = 0; i < queries.size(); i += n >= 4096 ? 100 : 1) {
+					reference += RayCastContains(hull, queries[i]) ? 1 : 0;
+				}
+			});
+			Report(n >= 4096 ? "Ray cast x1000" : "Ray cast x100000", hull.size(), ms, reference);
+
+			ms = BestOf(3, [&]() {
+				inside = 0;
+				for (size_t i = 0; i < queries.size(); i++) {
+					inside += HullMath::ContainsPoint(hull, queries[i]) ? 1 : 0;
+				}
+			});
+			Report("ContainsPoint x100000", hull.size(), ms, inside);
+
+			size_t located = 0;
+			Geometry::ConvexHullLocator locator(hull);
+			ms = BestOf(3, [&]() {
+				located = 0;
+				for (size_t i = 0; i < queries.size(); i++) {
+					located += locator.Contains(queries[i]) ? 1 : 0;
+				}
+			});
+			Report("ConvexHullLocator x100000", hull.size(), ms, located);
+
+			bool same = located == inside;
+			for (size_t i = 0; i < queries.size() && same; i += 100) {
+				same = RayCastContains(hull, queries[i]) == locator.Contains(queries[i]) && HullMath::ContainsPoint(hull, queries[i]) == locator.Contains(queries[i]);
+			}
+			std::printf("%-28s %s\n", "", same ? "same answers" : "ANSWERS DIFFER");
+		}
+	}
+
+	void BenchQueries() {
+		std::printf("-- point in hull / hull intersection --\n");
+		std::vector<Point2D> queries = SquareCloud(100000, 5);
+		for (size_t k = 8; k <= 256; k *= 2) {
+			std::vector<Point2D> hull = SortedHull(DiscCloud(k * 64, 6));
+			size_t inside = 0;
+
+			double ms = BestOf(3, [&]() {
+				inside = 0;
+				for (size_t i = 0; i < queries.size(); i++) {
+					inside += HullMath::ContainsPoint(hull, queries[i]) ? 1 : 0;
+				}
+			});
+			Report("ContainsPoint x100000", hull.size(), ms, inside);
+
+			Geometry::ConvexHullLocator locator(hull);
+			ms = BestOf(3, [&]() {
+				inside = 0;
+				for (size_t i = 0; i < queries.size(); i++) {
+					inside += locator.Contains(queries[i]) ? 1 : 0;
+				}
+			});
+			Report("ConvexHullLocator x100000", hull.size(), ms, inside);
+
+			/* Two overlapping hulls, a far apart pair and a small copy inside. The separated pair is the worst
+			case for the edge test (every edge pair is tested), and it gets the contained one wrong.
+			*/
+			std::vector<Point2D> other = hull;
+			std::vector<Point2D> far_away = hull;
+			std::vector<Point2D> inner = hull;
+			for (size_t i = 0; i < hull.size(); i++) {
+				other[i].x += 100.0;
+				far_away[i].x += 5000.0;
+				inner[i] = Point2D{ 500.0 + 0.5 * (hull[i].x - 500.0), 500.0 + 0.5 * (hull[i].y - 500.0) };
+			}
+			size_t hits = 0;
+			ms = BestOf(3, [&]() {
+				hits = 0;
+				for (int r = 0; r < 100; r++) {
+					hits += HullMath::EdgesIntersecting(hull, other) ? 1 : 0;
+					hits += HullMath::EdgesIntersecting(hull, far_away) ? 1 : 0;
+					hits += HullMath::EdgesIntersecting(hull, inner) ? 1 : 0;
+				}
+			});
+			Report("EdgesIntersecting x300", hull.size(), ms, hits);
+
+			ms = BestOf(3, [&]() {
+				hits = 0;
+				for (int r = 0; r < 100; r++) {
+					hits += HullMath::HullsIntersecting(hull, other) ? 1 : 0;
+					hits += HullMath::HullsIntersecting(hull, far_away) ? 1 : 0;
+					hits += HullMath::HullsIntersecting(hull, inner) ? 1 : 0;
+				}
+			});
+			Report("HullsIntersecting (GJK) x300", hull.size(), ms, hits);
+
+			Geometry::PolygonShape shape(hull);
+			Geometry::PolygonShape far_shape(far_away);
+			double distance = 0;
+			ms = BestOf(3, [&]() {
+				for (int r = 0; r < 100; r++) {
+					distance = Geometry::Gjk::Query(shape, far_shape).distance;
+				}
+			});
+			Report("Gjk distance x100", hull.size(), ms, (size_t)distance);
+
+			Geometry::PolygonShape overlapping(other);
+			Geometry::Epa::Contact contact;
+			ms = BestOf(3, [&]() {
+				for (int r = 0; r < 100; r++) {
+					Geometry::Epa::Penetration(shape, overlapping, contact);
+				}
+			});
+			Report("Gjk+Epa penetration x100", hull.size(), ms, (size_t)contact.depth);
+		}
+	}
+
+	/* One hull orbiting another a little each frame, in and out of contact, the way dragged hulls move: plain
+	GJK from the centers every frame against the warm-started cache. Same answers, fewer iterations.
+	*/
+	void BenchGjkWarmStart() {
+		std::printf("-- gjk warm start --\n");
+		const int frames = 20000;
+		std::vector<Point2D> fixed = SortedHull(DiscCloud(4096, 7));
+		std::vector<Point2D> base = SortedHull(DiscCloud(4096, 8));
+		std::vector<std::vector<Point2D>> path(frames, base);
+		for (int f = 0; f < frames; f++) {
+			double theta = 6.283185307179586 * f / 2000.0;
+			for (Point2D& point : path[f]) {
+				point.x += 1400.0 * std::cos(theta);
+				point.y += 900.0 * std::sin(theta);
+			}
+		}
+		Geometry::PolygonShape fixed_shape(fixed);
+
+		for (int mode = 0; mode < 2; mode++) {
+			bool distance = mode == 1;
+			uint64_t cold_iterations = 0;
+			size_t cold_hits = 0;
+			double ms = BestOf(3, [&]() {
+				cold_iterations = 0;
+				cold_hits = 0;
+				for (int f = 0; f < frames; f++) {
+					Geometry::PolygonShape moving(path[f]);
+					Geometry::MinkowskiDifferenceShape shape(moving, fixed_shape);
+					Geometry::Gjk::Result result = Geometry::Gjk::Query(shape, shape.Center(), !distance);
+					cold_iterations += result.iterations;
+					cold_hits += result.intersecting ? 1 : 0;
+				}
+			});
+			Report(distance ? "Gjk distance cold" : "Gjk boolean cold", frames, ms, cold_hits);
+			std::printf("%-28s %.2f iterations a query\n", "", (double)cold_iterations / frames);
+
+			Geometry::GjkCache cache;
+			size_t warm_hits = 0;
+			ms = BestOf(3, [&]() {
+				cache.Clear();
+				cache.ResetStats();
+				warm_hits = 0;
+				for (int f = 0; f < frames; f++) {
+					Geometry::PolygonShape moving(path[f]);
+					Geometry::MinkowskiDifferenceShape shape(moving, fixed_shape);
+					bool hit = distance ? cache.Query(1, shape).intersecting : cache.Intersecting(1, shape);
+					warm_hits += hit ? 1 : 0;
+				}
+			});
+			Report(distance ? "Gjk distance warm" : "Gjk boolean warm", frames, ms, warm_hits);
+			const Geometry::GjkCache::Stats& stats = cache.Totals();
+			std::printf("%-28s %.2f iterations a query, %llu early outs, %s\n", "", cache.AverageIterations(),
+				(unsigned long long)stats.early_outs, warm_hits == cold_hits ? "same answers" : "ANSWERS DIFFER");
+		}
+	}
+
+	/* Lots of small hulls drifting around a square, about as crowded whatever their number: each one a hull
+	(kept around its own origin) plus a position and a velocity. The boxes are the hulls' bounds moved there.
+	*/
+	struct Scene {
+		std::vector<std::vector<Point2D>> hulls;
+		std::vector<Geometry::Aabb> bounds;
+		std::vector<Point2D> positions;
+		std::vector<Point2D> velocities;
+		double side;
+
+		Geometry::Aabb Box(size_t i) const {
+			return Geometry::Aabb{ bounds[i].min + positions[i], bounds[i].max + positions[i] };
+		}
+
+		// Bouncing off the walls.
+		void Step() {
+			for (size_t i = 0; i < positions.size(); i++) {
+				Point2D& p = positions[i];
+				Point2D& v = velocities[i];
+				p = p + v;
+				if (p.x < 0 || p.x > side) {
+					v.x = -v.x;
+				}
+				if (p.y < 0 || p.y > side) {
+					v.y = -v.y;
+				}
+			}
+		}
+	};
+
+	Scene MakeScene(size_t n, unsigned seed) {
+		std::mt19937 rng(seed);
+		std::uniform_real_distribution<double> unit(0.0, 1.0);
+		Scene scene;
+		scene.side = 40.0 * std::sqrt((double)n);
+		for (size_t i = 0; i < n; i++) {
+			std::vector<Point2D> cloud(8);
+			for (Point2D& point : cloud) {
+				point = Point2D{ 20.0 * unit(rng) - 10.0, 20.0 * unit(rng) - 10.0 };
+			}
+			scene.hulls.push_back(SortedHull(cloud));
+			scene.bounds.push_back(Geometry::BoundsOf(scene.hulls.back()));
+			scene.positions.push_back(Point2D{ scene.side * unit(rng), scene.side * unit(rng) });
+			scene.velocities.push_back(Point2D{ 2.0 * unit(rng) - 1.0, 2.0 * unit(rng) - 1.0 });
+		}
+		return scene;
+	}
+
+	/* The same, but every 16th hull a QuickHull of 64 points across 800: a few big hulls among many small ones.
+	A sweep finds each big one overlapping everything along its axis, and no grid cell fits both sizes.
+	*/
+	Scene MakeMixedScene(size_t n, unsigned seed) {
+		Scene scene = MakeScene(n, seed);
+		std::mt19937 rng(seed + 1);
+		std::uniform_real_distribution<double> unit(0.0, 1.0);
+		for (size_t i = 0; i < n; i += 16) {
+			std::vector<Point2D> cloud(64);
+			for (Point2D& point : cloud) {
+				double angle = 6.283185307179586 * unit(rng);
+				double radius = 400.0 * std::sqrt(unit(rng));
+				point = Point2D{ radius * std::cos(angle), radius * std::sin(angle) };
+			}
+			scene.hulls[i] = QuickHullOrdered(cloud);
+			scene.bounds[i] = Geometry::BoundsOf(scene.hulls[i]);
+		}
+		return scene;
+	}
+
+	// Pairs sorted, so two broadphases' answers can be compared.
+	std::vector<Geometry::Broadphase::Pair> SortedPairs(std::vector<Geometry::Broadphase::Pair> pairs) {
+		std::sort(pairs.begin(), pairs.end(), [](const Geometry::Broadphase::Pair& a, const Geometry::Broadphase::Pair& b) {
+			return a.first < b.first || (a.first == b.first && a.second < b.second);
+		});
+		return pairs;
+	}
+
+	bool SamePairs(const std::vector<Geometry::Broadphase::Pair>& a, const std::vector<Geometry::Broadphase::Pair>& b) {
+		if (a.size() != b.size()) {
+			return false;
+		}
+		for (size_t i = 0; i < a.size(); i++) {
+			if (a[i].first != b[i].first || a[i].second != b[i].second) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/* frames frames of the scene through broadphase: every box moved, then FindPairs. Returns ms a frame;
+	tests and pairs are per frame too, last the pairs of the last frame.
+	*/
+	double RunBroadphase(Geometry::Broadphase& broadphase, const Scene& start, int frames, double& tests, double& pairs,
+		std::vector<Geometry::Broadphase::Pair>& last) {
+		Scene scene = start;
+		for (size_t i = 0; i < scene.positions.size(); i++) {
+			broadphase.Add((Geometry::Broadphase::Id)i, scene.Box(i));
+		}
+		tests = 0;
+		pairs = 0;
+		auto begin = std::chrono::steady_clock::now();
+		for (int f = 0; f < frames; f++) {
+			scene.Step();
+			for (size_t i = 0; i < scene.positions.size(); i++) {
+				broadphase.Move((Geometry::Broadphase::Id)i, scene.Box(i));
+			}
+			broadphase.FindPairs(last);
+			tests += (double)broadphase.LastStats().box_tests;
+			pairs += (double)broadphase.LastStats().pairs;
+		}
+		double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+		tests /= frames;
+		pairs /= frames;
+		return ms / frames;
+	}
+
+	/* Box tests and candidate pairs a frame, sweep and prune against all pairs, and how many candidates really
+	touch (GJK on the hulls where they are now), which is all the narrowphase gets to see.
+	*/
+	void BenchBroadphase(size_t max_points) {
+		std::printf("-- broadphase: sweep and prune --\n");
+		const int frames = 10;
+		for (size_t n = 1000; n <= 16000 && n <= max_points; n *= 4) {
+			Scene scene = MakeScene(n, 9);
+			double tests = 0;
+			double pairs = 0;
+			std::vector<Geometry::Broadphase::Pair> reference;
+			Geometry::BruteForceBroadphase brute;
+			double ms = RunBroadphase(brute, scene, frames, tests, pairs, reference);
+			std::printf("%-28s n=%-9zu %10.3f ms a frame, %.0f box tests, %.0f pairs\n", brute.Name(), n, ms, tests, pairs);
+
+			std::vector<Geometry::Broadphase::Pair> found;
+			Geometry::SweepAndPrune sap;
+			ms = RunBroadphase(sap, scene, frames, tests, pairs, found);
+			std::printf("%-28s n=%-9zu %10.3f ms a frame, %.0f box tests, %.0f pairs, %llu swaps last frame\n", sap.Name(), n, ms, tests, pairs,
+				(unsigned long long)sap.LastSwaps());
+
+			// The scene as it is after the last frame, for the narrowphase.
+			Scene moved = scene;
+			for (int f = 0; f < frames; f++) {
+				moved.Step();
+			}
+			size_t touching = 0;
+			std::vector<Point2D> first;
+			std::vector<Point2D> second;
+			for (const Geometry::Broadphase::Pair& pair : found) {
+				first = moved.hulls[pair.first];
+				second = moved.hulls[pair.second];
+				for (Point2D& point : first) {
+					point = point + moved.positions[pair.first];
+				}
+				for (Point2D& point : second) {
+					point = point + moved.positions[pair.second];
+				}
+				touching += HullMath::HullsIntersecting(first, second) ? 1 : 0;
+			}
+			std::printf("%-28s %zu of %zu candidates touch (all pairs: %zu), %s\n", "", touching, found.size(), n * (n - 1) / 2,
+				SamePairs(SortedPairs(found), SortedPairs(reference)) ? "same pairs" : "PAIRS DIFFER");
+		}
+	}
+
+	/* The tree against sweep and prune, on the even scene and the mixed one: time and box tests a frame, how
+	deep and how tight the tree is, and how many leaves the moves had to reinsert. Then region and ray queries
+	on the tree where the scene ended up, against testing every box.
+	*/
+	void BenchDynamicTree(size_t max_points) {
+		std::printf("-- broadphase: dynamic tree --\n");
+		const int frames = 10;
+		const size_t queries = 1000;
+		for (int mixed = 0; mixed < 2; mixed++) {
+			for (size_t n = 1000; n <= 16000 && n <= max_points; n *= 4) {
+				Scene scene = mixed ? MakeMixedScene(n, 9) : MakeScene(n, 9);
+				const char* kind = mixed ? "mixed" : "even";
+				double tests = 0;
+				double pairs = 0;
+				char name[64];
+
+				std::vector<Geometry::Broadphase::Pair> reference;
+				Geometry::SweepAndPrune sap;
+				double ms = RunBroadphase(sap, scene, frames, tests, pairs, reference);
+				std::snprintf(name, sizeof(name), "%s %s", sap.Name(), kind);
+				std::printf("%-28s n=%-9zu %10.3f ms a frame, %.0f box tests, %.0f pairs\n", name, n, ms, tests, pairs);
+
+				std::vector<Geometry::Broadphase::Pair> found;
+				Geometry::DynamicTree tree;
+				ms = RunBroadphase(tree, scene, frames, tests, pairs, found);
+				std::snprintf(name, sizeof(name), "%s %s", tree.Name(), kind);
+				std::printf("%-28s n=%-9zu %10.3f ms a frame, %.0f box tests, %.0f pairs\n", name, n, ms, tests, pairs);
+				std::printf("%-28s height %d, cost %.0f, %llu reinserts last frame, %s\n", "", tree.Height(), tree.Cost(),
+					(unsigned long long)tree.LastReinserts(), SamePairs(SortedPairs(found), SortedPairs(reference)) ? "same pairs" : "PAIRS DIFFER");
+
+				Scene moved = scene;
+				for (int f = 0; f < frames; f++) {
+					moved.Step();
+				}
+				std::vector<Geometry::Aabb> boxes;
+				for (size_t i = 0; i < n; i++) {
+					boxes.push_back(moved.Box(i));
+				}
+				std::mt19937 rng(21);
+				std::uniform_real_distribution<double> unit(0.0, 1.0);
+				std::vector<Geometry::Aabb> regions;
+				std::vector<Point2D> origins;
+				std::vector<Point2D> directions;
+				for (size_t q = 0; q < queries; q++) {
+					Point2D corner = { moved.side * unit(rng), moved.side * unit(rng) };
+					regions.push_back(Geometry::Aabb{ corner, corner + Point2D{ 100, 100 } });
+					origins.push_back(Point2D{ moved.side * unit(rng), moved.side * unit(rng) });
+					double angle = 6.283185307179586 * unit(rng);
+					directions.push_back(Point2D{ std::cos(angle), std::sin(angle) });
+				}
+
+				// n is the scene's box count; how many regions or rays each row casts is in its name.
+				size_t scanned = 0;
+				ms = BestOf(3, [&]() {
+					scanned = 0;
+					for (const Geometry::Aabb& region : regions) {
+						for (const Geometry::Aabb& box : boxes) {
+							scanned += Geometry::Overlaps(box, region) ? 1 : 0;
+						}
+					}
+				});
+				std::snprintf(name, sizeof(name), "Region scan, %zu queries", queries);
+				Report(name, n, ms, scanned);
+				size_t hits = 0;
+				std::vector<Geometry::Broadphase::Id> ids;
+				ms = BestOf(3, [&]() {
+					hits = 0;
+					for (const Geometry::Aabb& region : regions) {
+						tree.Query(region, ids);
+						hits += ids.size();
+					}
+				});
+				std::snprintf(name, sizeof(name), "Region tree, %zu queries", queries);
+				Report(name, n, ms, hits);
+				std::printf("%-28s %s\n", "", hits == scanned ? "same hits" : "HITS DIFFER");
+
+				// Slab test against every box: the ray's stretch inside each axis' slab, cut to [0, max_t].
+				const double max_t = 500;
+				auto slab = [&](const Point2D& origin, const Point2D& direction, const Geometry::Aabb& box) {
+					double enter = 0;
+					double leave = max_t;
+					const double o[2] = { origin.x, origin.y };
+					const double d[2] = { direction.x, direction.y };
+					const double lo[2] = { box.min.x, box.min.y };
+					const double hi[2] = { box.max.x, box.max.y };
+					for (int axis = 0; axis < 2; axis++) {
+						if (d[axis] == 0) {
+							if (o[axis] < lo[axis] || o[axis] > hi[axis]) {
+								return false;
+							}
+							continue;
+						}
+						double a = (lo[axis] - o[axis]) / d[axis];
+						double b = (hi[axis] - o[axis]) / d[axis];
+						enter = std::max(enter, std::min(a, b));
+						leave = std::min(leave, std::max(a, b));
+					}
+					return enter <= leave;
+				};
+				std::vector<std::vector<Geometry::Broadphase::Id>> scan_hits(queries);
+				size_t ray_scanned = 0;
+				ms = BestOf(3, [&]() {
+					ray_scanned = 0;
+					for (size_t q = 0; q < queries; q++) {
+						scan_hits[q].clear();
+						for (size_t i = 0; i < n; i++) {
+							if (slab(origins[q], directions[q], boxes[i])) {
+								scan_hits[q].push_back((Geometry::Broadphase::Id)i);
+							}
+						}
+						ray_scanned += scan_hits[q].size();
+					}
+				});
+				std::snprintf(name, sizeof(name), "Ray scan, %zu queries", queries);
+				Report(name, n, ms, ray_scanned);
+				std::vector<Geometry::DynamicTree::RayHit> ray_hits;
+				ms = BestOf(3, [&]() {
+					hits = 0;
+					for (size_t q = 0; q < queries; q++) {
+						tree.RayCast(origins[q], directions[q], max_t, ray_hits);
+						hits += ray_hits.size();
+					}
+				});
+				std::snprintf(name, sizeof(name), "Ray tree, %zu queries", queries);
+				Report(name, n, ms, hits);
+
+				// Same boxes hit, nearest first.
+				bool same = true;
+				for (size_t q = 0; q < queries && same; q++) {
+					tree.RayCast(origins[q], directions[q], max_t, ray_hits);
+					ids.clear();
+					for (size_t k = 0; k < ray_hits.size(); k++) {
+						ids.push_back(ray_hits[k].id);
+						same = same && (k == 0 || ray_hits[k - 1].t <= ray_hits[k].t);
+					}
+					std::sort(ids.begin(), ids.end());
+					same = same && ids == scan_hits[q];
+				}
+				std::printf("%-28s %s\n", "", same ? "same hits" : "HITS DIFFER");
+			}
+		}
+	}
+
+	/* Every broadphase from CreateBroadphase on the even and the mixed scene, each frame split in three: moving
+	the boxes, Build, and FindPairs on what Build left. Brute force only up to 4000. only, if set, picks one
+	broadphase by name. Then the spatial hash's cell size against the even scene.
+	*/
+	void BenchBroadphases(size_t max_points, const char* only) {
+		std::printf("-- broadphase: all of them --\n");
+		const int frames = 10;
+		for (int mixed = 0; mixed < 2; mixed++) {
+			for (size_t n = 1000; n <= 16000 && n <= max_points; n *= 4) {
+				Scene start = mixed ? MakeMixedScene(n, 9) : MakeScene(n, 9);
+				std::vector<Geometry::Broadphase::Pair> reference;
+				for (Geometry::BroadphaseType type : Geometry::BroadphaseTypes) {
+					std::unique_ptr<Geometry::Broadphase> broadphase = Geometry::CreateBroadphase(type);
+					if ((only && std::strcmp(only, broadphase->Name()) != 0) || (type == Geometry::BroadphaseType::BruteForce && n > 4000)) {
+						continue;
+					}
+
+					Scene scene = start;
+					for (size_t i = 0; i < n; i++) {
+						broadphase->Add((Geometry::Broadphase::Id)i, scene.Box(i));
+					}
+					double update_ms = 0;
+					double build_ms = 0;
+					double pairs_ms = 0;
+					std::vector<Geometry::Broadphase::Pair> found;
+					for (int f = 0; f < frames; f++) {
+						scene.Step();
+						auto begin = std::chrono::steady_clock::now();
+						for (size_t i = 0; i < n; i++) {
+							broadphase->Move((Geometry::Broadphase::Id)i, scene.Box(i));
+						}
+						auto moved = std::chrono::steady_clock::now();
+						broadphase->Build();
+						auto built = std::chrono::steady_clock::now();
+						broadphase->FindPairs(found);
+						auto done = std::chrono::steady_clock::now();
+						update_ms += std::chrono::duration<double, std::milli>(moved - begin).count();
+						build_ms += std::chrono::duration<double, std::milli>(built - moved).count();
+						pairs_ms += std::chrono::duration<double, std::milli>(done - built).count();
+					}
+
+					found = SortedPairs(found);
+					if (reference.empty()) {
+						reference = found;
+					}
+					char name[64];
+					std::snprintf(name, sizeof(name), "%s %s", broadphase->Name(), mixed ? "mixed" : "even");
+					std::printf("%-28s n=%-9zu moves %7.3f  build %7.3f  pairs %7.3f ms a frame, %zu pairs, %s\n", name, n,
+						update_ms / frames, build_ms / frames, pairs_ms / frames, found.size(), SamePairs(found, reference) ? "same" : "DIFFER");
+				}
+			}
+		}
+
+		if (only && std::strcmp(only, "spatial hash") != 0) {
+			return;
+		}
+		size_t n = std::min<size_t>(16000, max_points);
+		Scene scene = MakeScene(n, 9);
+		for (double cell = 8; cell <= 128; cell *= 2) {
+			Geometry::SpatialHash hash(cell);
+			for (size_t i = 0; i < n; i++) {
+				hash.Add((Geometry::Broadphase::Id)i, scene.Box(i));
+			}
+			std::vector<Geometry::Broadphase::Pair> found;
+			double build_ms = BestOf(3, [&]() { hash.Build(); });
+			double pairs_ms = BestOf(3, [&]() { hash.FindPairs(found); });
+			char name[64];
+			std::snprintf(name, sizeof(name), "spatial hash cell %.0f", cell);
+			std::printf("%-28s n=%-9zu build %7.3f  pairs %7.3f ms, %.2f cells a box, %llu box tests, %zu pairs\n", name, n, build_ms, pairs_ms,
+				(double)hash.Entries() / n, (unsigned long long)hash.LastStats().box_tests, found.size());
+		}
+	}
+}
+
+int main(int argc, char** argv) {
+	size_t max_points = 100000;
+	if (argc > 1) {
+		// strtoull would take "-5" as a huge count, so only plain digits.
+		char* end = nullptr;
+		max_points = std::strtoull(argv[1], &end, 10);
+		if (!std::isdigit((unsigned char)argv[1][0]) || *end != '\0' || max_points == 0) {
+			std::fprintf(stderr, "usage: hullbench [max_points] [broadphase]\n");
+			return 2;
+		}
+	}
+	// A broadphase by name ("spatial hash"), for the broadphase comparison.
+	const char* broadphase = argc > 2 ? argv[2] : nullptr;
+
+	BenchHulls(max_points);
+	BenchParallelHull(max_points);
+	BenchHullMerge(max_points);
+	BenchKernels(max_points);
+	BenchPrefilter(max_points);
+	BenchDynamicHull(max_points);
+	BenchPredicates(max_points);
+	BenchBatchHull();
+	BenchHullCache();
+	BenchMinkowski();
+	BenchQueries();
+	BenchContainment();
+	BenchClassify();
+	BenchPicking();
+	BenchPointStore();
+	BenchGjkWarmStart();
+	BenchBroadphase(max_points);
+	BenchDynamicTree(max_points);
+	BenchBroadphases(max_points, broadphase);
+	return 0;
+}
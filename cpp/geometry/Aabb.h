@@ -0,0 +1,67 @@
+#ifndef _GEOMETRY_AABB_H
+#define _GEOMETRY_AABB_H
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace Geometry {
+
+	// Axis-aligned box, min and max corners included. What the broadphases sort, hash and nest.
+	struct Aabb {
+		Point2D min;
+		Point2D max;
+	};
+
+	// Touching boxes overlap, like touching hulls do.
+	inline bool Overlaps(const Aabb& a, const Aabb& b) {
+		return a.min.x <= b.max.x && b.min.x <= a.max.x && a.min.y <= b.max.y && b.min.y <= a.max.y;
+	}
+
+	inline bool Contains(const Aabb& outer, const Aabb& inner) {
+		return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && inner.max.x <= outer.max.x && inner.max.y <= outer.max.y;
+	}
+
+	inline Aabb Union(const Aabb& a, const Aabb& b) {
+		return Aabb{ Point2D{ a.min.x < b.min.x ? a.min.x : b.min.x, a.min.y < b.min.y ? a.min.y : b.min.y },
+			Point2D{ a.max.x > b.max.x ? a.max.x : b.max.x, a.max.y > b.max.y ? a.max.y : b.max.y } };
+	}
+
+	// The 2D stand-in for surface area in the surface area heuristic.
+	inline double Perimeter(const Aabb& a) {
+		return 2.0 * ((a.max.x - a.min.x) + (a.max.y - a.min.y));
+	}
+
+	inline Aabb Fatten(const Aabb& a, double margin) {
+		return Aabb{ Point2D{ a.min.x - margin, a.min.y - margin }, Point2D{ a.max.x + margin, a.max.y + margin } };
+	}
+
+	// Bounds of a hull (or any points); n must not be 0.
+	inline Aabb BoundsOf(const Point2D* points, size_t n) {
+		Aabb box = { points[0], points[0] };
+		for (size_t i = 1; i < n; i++) {
+			box = Union(box, Aabb{ points[i], points[i] });
+		}
+		return box;
+	}
+
+	inline Aabb BoundsOf(const std::vector<Point2D>& points) {
+		return BoundsOf(points.data(), points.size());
+	}
+
+	// The same from structure of arrays (a PointStore's X and Y).
+	inline Aabb BoundsOf(const double* x, const double* y, size_t n) {
+		Aabb box = { Point2D{ x[0], y[0] }, Point2D{ x[0], y[0] } };
+		for (size_t i = 1; i < n; i++) {
+			box.min.x = x[i] < box.min.x ? x[i] : box.min.x;
+			box.min.y = y[i] < box.min.y ? y[i] : box.min.y;
+			box.max.x = x[i] > box.max.x ? x[i] : box.max.x;
+			box.max.y = y[i] > box.max.y ? y[i] : box.max.y;
+		}
+		return box;
+	}
+}
+
+#endif
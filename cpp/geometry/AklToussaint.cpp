@@ -0,0 +1,82 @@
+#include "AklToussaint.h"
+
+#include "HullKernels.h"
+
+namespace Geometry {
+
+	size_t AklToussaint::Octagon(const double* x, const double* y, size_t n, Point2D (&octagon)[MaxCorners]) {
+		if (n == 0) {
+			return 0;
+		}
+
+		/* Extremes in the directions -x, -(x + y), -y, x - y, x, x + y, y, y - x: going round in that order
+		visits them counterclockwise. Ties keep the first point found, which is fine, since any extreme point
+		in a direction lies on the hull.
+		*/
+		size_t extreme[MaxCorners] = { 0, 0, 0, 0, 0, 0, 0, 0 };
+		for (size_t i = 1; i < n; i++) {
+			double sum = x[i] + y[i];
+			double diff = x[i] - y[i];
+			if (x[i] < x[extreme[0]] || (x[i] == x[extreme[0]] && y[i] < y[extreme[0]])) {
+				extreme[0] = i;
+			}
+			if (sum < x[extreme[1]] + y[extreme[1]]) {
+				extreme[1] = i;
+			}
+			if (y[i] < y[extreme[2]]) {
+				extreme[2] = i;
+			}
+			if (diff > x[extreme[3]] - y[extreme[3]]) {
+				extreme[3] = i;
+			}
+			if (x[i] > x[extreme[4]]) {
+				extreme[4] = i;
+			}
+			if (sum > x[extreme[5]] + y[extreme[5]]) {
+				extreme[5] = i;
+			}
+			if (y[i] > y[extreme[6]]) {
+				extreme[6] = i;
+			}
+			if (diff < x[extreme[7]] - y[extreme[7]]) {
+				extreme[7] = i;
+			}
+		}
+
+		size_t corners = 0;
+		for (size_t d = 0; d < MaxCorners; d++) {
+			Point2D p = { x[extreme[d]], y[extreme[d]] };
+			if (corners == 0 || p != octagon[corners - 1]) {
+				octagon[corners++] = p;
+			}
+		}
+		while (corners > 1 && octagon[corners - 1] == octagon[0]) {
+			corners--;
+		}
+		return corners;
+	}
+
+	size_t AklToussaint::Filter(double* x, double* y, size_t n) {
+		Point2D octagon[MaxCorners];
+		size_t corners = Octagon(x, y, n, octagon);
+		return HullKernels::CullInside(x, y, n, octagon, corners);
+	}
+
+	std::vector<Point2D> AklToussaint::Filter(const std::vector<Point2D>& points, size_t& culled) {
+		std::vector<double> xs(points.size());
+		std::vector<double> ys(points.size());
+		for (size_t i = 0; i < points.size(); i++) {
+			xs[i] = points[i].x;
+			ys[i] = points[i].y;
+		}
+
+		size_t kept = Filter(xs.data(), ys.data(), points.size());
+		culled = points.size() - kept;
+
+		std::vector<Point2D> survivors(kept);
+		for (size_t i = 0; i < kept; i++) {
+			survivors[i] = Point2D{ xs[i], ys[i] };
+		}
+		return survivors;
+	}
+}
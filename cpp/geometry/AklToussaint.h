@@ -0,0 +1,39 @@
+#ifndef _GEOMETRY_AKLTOUSSAINT_H
+#define _GEOMETRY_AKLTOUSSAINT_H
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace Geometry {
+
+	/* Akl–Toussaint heuristic: a cheap pre-filter in front of any hull engine.
+
+	The extreme points in the 8 directions x, y, x + y and x - y (min and max of each) span an octagon that lies
+	inside the hull, so nothing strictly inside it can be a hull vertex. On dense, roughly uniform clouds that is
+	most of the input. Finding the octagon is one scalar pass, throwing the inside away is one vectorized pass
+	(HullKernels::CullInside), and the hull engine only ever sees the survivors.
+
+	Points on the octagon's boundary survive, so the hull of the survivors is exactly the hull of the input.
+	*/
+	class AklToussaint {
+
+	public:
+		static const size_t MaxCorners = 8;
+
+		/* The extreme points of x[0, n) / y[0, n) in counterclockwise order, starting with the lowest x, with
+		repeated corners removed (a square cloud usually has fewer than 8). Returns the number of corners.
+		*/
+		static size_t Octagon(const double* x, const double* y, size_t n, Point2D (&octagon)[MaxCorners]);
+
+		// Filters x[0, n) / y[0, n) in place; returns how many points are left in front.
+		static size_t Filter(double* x, double* y, size_t n);
+
+		// Copying version for point lists. culled gets how many points were dropped.
+		static std::vector<Point2D> Filter(const std::vector<Point2D>& points, size_t& culled);
+	};
+}
+
+#endif
@@ -0,0 +1,99 @@
+#include "BatchHull.h"
+
+#include <algorithm>
+
+#include "HullKernels.h"
+#include "MonotoneChain.h"
+
+namespace Geometry {
+
+	namespace {
+
+		const size_t Lanes = HullKernels::SmallHullLanes;
+
+		/* Up to Lanes sets of n points each through one kernel call. Lanes without a set get copies of the first
+		one and are thrown away. Each hull goes to where its set starts in the output; that always fits, and
+		GetConvexHulls packs them afterwards.
+		*/
+		void HullGroup(const Point2D* points, const size_t* offsets, const size_t* group, size_t count, size_t n, Point2D* hulls, size_t* sizes) {
+			double x[Lanes * BatchHull::MaxSmallSet];
+			double y[Lanes * BatchHull::MaxSmallSet];
+			for (size_t lane = 0; lane < Lanes; lane++) {
+				const Point2D* set = points + offsets[group[lane < count ? lane : 0]];
+				for (size_t k = 0; k < n; k++) {
+					x[Lanes * k + lane] = set[k].x;
+					y[Lanes * k + lane] = set[k].y;
+				}
+			}
+
+			double hull_x[Lanes * (BatchHull::MaxSmallSet + 1)];
+			double hull_y[Lanes * (BatchHull::MaxSmallSet + 1)];
+			size_t hull_sizes[Lanes];
+			HullKernels::SmallHulls(x, y, n, hull_x, hull_y, hull_sizes);
+
+			for (size_t lane = 0; lane < count; lane++) {
+				size_t set = group[lane];
+				Point2D* hull = hulls + (offsets[set] - offsets[0]);
+				for (size_t k = 0; k < hull_sizes[lane]; k++) {
+					hull[k] = Point2D{ hull_x[Lanes * k + lane], hull_y[Lanes * k + lane] };
+				}
+				sizes[set] = hull_sizes[lane];
+			}
+		}
+	}
+
+	size_t BatchHull::GetConvexHulls(const Point2D* points, const size_t* offsets, size_t sets, Point2D* hulls, size_t* hull_offsets) {
+		// Set indices by size, so that every network run is full of sets of the same size.
+		std::vector<size_t> by_size[MaxSmallSet + 1];
+		std::vector<size_t> sizes(sets, 0);
+		std::vector<Point2D> large;
+		std::vector<Point2D> large_hull;
+
+		for (size_t i = 0; i < sets; i++) {
+			size_t n = offsets[i + 1] - offsets[i];
+			if (n == 0) {
+				continue;
+			}
+			if (n <= MaxSmallSet) {
+				by_size[n].push_back(i);
+				continue;
+			}
+			large.assign(points + offsets[i], points + offsets[i + 1]);
+			large_hull.resize(n + 1);
+			size_t h = MonotoneChain::GetConvexHull(large.data(), n, large_hull.data());
+			std::copy(large_hull.begin(), large_hull.begin() + h, hulls + (offsets[i] - offsets[0]));
+			sizes[i] = h;
+		}
+
+		for (size_t n = 1; n <= MaxSmallSet; n++) {
+			const std::vector<size_t>& group = by_size[n];
+			for (size_t first = 0; first < group.size(); first += Lanes) {
+				size_t count = std::min(Lanes, group.size() - first);
+				HullGroup(points, offsets, group.data() + first, count, n, hulls, sizes.data());
+			}
+		}
+
+		// Pack the hulls to the front. Each one only ever moves towards the start, so one forward pass does it.
+		size_t written = 0;
+		for (size_t i = 0; i < sets; i++) {
+			const Point2D* hull = hulls + (offsets[i] - offsets[0]);
+			hull_offsets[i] = written;
+			std::copy(hull, hull + sizes[i], hulls + written);
+			written += sizes[i];
+		}
+		hull_offsets[sets] = written;
+		return written;
+	}
+
+	void BatchHull::GetConvexHulls(const std::vector<Point2D>& points, const std::vector<size_t>& offsets, std::vector<Point2D>& hulls, std::vector<size_t>& hull_offsets) {
+		if (offsets.empty()) {
+			hulls.clear();
+			hull_offsets.assign(1, 0);
+			return;
+		}
+		size_t sets = offsets.size() - 1;
+		hulls.resize(offsets.back() - offsets.front());
+		hull_offsets.resize(sets + 1);
+		hulls.resize(GetConvexHulls(points.data(), offsets.data(), sets, hulls.data(), hull_offsets.data()));
+	}
+}
@@ -0,0 +1,43 @@
+#ifndef _GEOMETRY_BATCHHULL_H
+#define _GEOMETRY_BATCHHULL_H
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "HullKernels.h"
+#include "Point2D.h"
+
+namespace Geometry {
+
+	/* Lots of small hulls in one call: a few thousand sets of 4 to 16 points each, say, one per unit on the map.
+
+	The sets come packed back to back in one buffer, with offsets to where each one starts, and the hulls come
+	back the same way. Sets of up to 16 points are grouped by size and go through HullKernels::SmallHulls four
+	at a time, one set per SIMD lane. Only the sort is vectorised: a sorting network for exactly that size puts
+	all four sets in order side by side, then the monotone chain sweep (MonotoneChain::ChainSorted) runs on one
+	lane after the other, since every set pops a different number of points. Without SSE2 the kernel falls back
+	to MonotoneChain on each set, std::sort included, and sets bigger than 16 always go through MonotoneChain.
+
+	Every hull has the usual contract: counterclockwise (y up), starting at the lowest-x point, no collinear
+	points or duplicates. Identical to MonotoneChain on each set.
+	*/
+	class BatchHull {
+
+	public:
+		// Sets up to this size take the sorting network path.
+		static const size_t MaxSmallSet = HullKernels::MaxSmallHull;
+
+		/* Set i is points[offsets[i], offsets[i + 1]), so offsets has sets + 1 entries. Hull i is written to
+		hulls[hull_offsets[i], hull_offsets[i + 1]) with hull_offsets[0] = 0. hulls needs room for
+		offsets[sets] - offsets[0] points (a hull is never bigger than its set), hull_offsets for sets + 1
+		entries. Returns the number of hull vertices written in all.
+		*/
+		static size_t GetConvexHulls(const Point2D* points, const size_t* offsets, size_t sets, Point2D* hulls, size_t* hull_offsets);
+
+		// Same, with the output vectors sized to fit. offsets may be empty (no sets).
+		static void GetConvexHulls(const std::vector<Point2D>& points, const std::vector<size_t>& offsets, std::vector<Point2D>& hulls, std::vector<size_t>& hull_offsets);
+	};
+}
+
+#endif
@@ -0,0 +1,64 @@
+#include "Broadphase.h"
+
+#include "DynamicTree.h"
+#include "SpatialHash.h"
+#include "SweepAndPrune.h"
+
+namespace Geometry {
+
+	namespace {
+
+		const size_t NoSlot = (size_t)-1;
+	}
+
+	void BruteForceBroadphase::Add(Id id, const Aabb& box) {
+		if (id >= slots.size()) {
+			slots.resize((size_t)id + 1, NoSlot);
+		}
+		slots[id] = boxes.size();
+		boxes.push_back(box);
+		ids.push_back(id);
+	}
+
+	void BruteForceBroadphase::Move(Id id, const Aabb& box) {
+		boxes[slots[id]] = box;
+	}
+
+	// The last box takes the removed one's place.
+	void BruteForceBroadphase::Remove(Id id) {
+		size_t slot = slots[id];
+		boxes[slot] = boxes.back();
+		ids[slot] = ids.back();
+		slots[ids[slot]] = slot;
+		boxes.pop_back();
+		ids.pop_back();
+		slots[id] = NoSlot;
+	}
+
+	void BruteForceBroadphase::FindPairs(std::vector<Pair>& out) {
+		out.clear();
+		for (size_t i = 0; i < boxes.size(); i++) {
+			for (size_t j = i + 1; j < boxes.size(); j++) {
+				if (Overlaps(boxes[i], boxes[j])) {
+					out.push_back(ids[i] < ids[j] ? Pair{ ids[i], ids[j] } : Pair{ ids[j], ids[i] });
+				}
+			}
+		}
+		size_t n = boxes.size();
+		stats.box_tests = n * (n - (n > 0 ? 1 : 0)) / 2;
+		stats.pairs = out.size();
+	}
+
+	std::unique_ptr<Broadphase> CreateBroadphase(BroadphaseType type) {
+		switch (type) {
+		case BroadphaseType::SweepAndPrune:
+			return std::unique_ptr<Broadphase>(new SweepAndPrune());
+		case BroadphaseType::DynamicTree:
+			return std::unique_ptr<Broadphase>(new DynamicTree());
+		case BroadphaseType::SpatialHash:
+			return std::unique_ptr<Broadphase>(new SpatialHash());
+		default:
+			return std::unique_ptr<Broadphase>(new BruteForceBroadphase());
+		}
+	}
+}
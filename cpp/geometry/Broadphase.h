@@ -0,0 +1,93 @@
+#ifndef _GEOMETRY_BROADPHASE_H
+#define _GEOMETRY_BROADPHASE_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Aabb.h"
+
+namespace Geometry {
+
+	/* The cheap first pass of collision detection: from the boxes around many hulls, the pairs whose boxes
+	overlap. Only those go on to the narrowphase (Gjk, Epa), instead of all n (n - 1) / 2 of them.
+
+	Every box has an id picked by the caller; ids are meant to be small (indices into the caller's own array
+	of hulls), the broadphases size tables by the largest one. Boxes are added, moved every frame and removed,
+	and FindPairs reports what overlaps now.
+	*/
+	class Broadphase {
+
+	public:
+		typedef uint32_t Id;
+
+		// first < second.
+		struct Pair {
+			Id first;
+			Id second;
+		};
+
+		// Of the last FindPairs.
+		struct Stats {
+			uint64_t box_tests;		// Box against box overlap tests.
+			uint64_t pairs;			// Pairs reported.
+		};
+
+		virtual ~Broadphase() {}
+
+		virtual void Add(Id id, const Aabb& box) = 0;
+		virtual void Move(Id id, const Aabb& box) = 0;
+		virtual void Remove(Id id) = 0;
+
+		/* Brings whatever FindPairs searches up to date with the changes since the last call; FindPairs does it
+		first otherwise. Only separate so the two can be timed apart.
+		*/
+		virtual void Build() {}
+
+		// Every pair of boxes that overlap (touching counts) once, in no particular order. Replaces out.
+		virtual void FindPairs(std::vector<Pair>& out) = 0;
+
+		virtual const char* Name() const = 0;
+
+		const Stats& LastStats() const { return stats; }
+
+	protected:
+		Broadphase() : stats(Stats{ 0, 0 }) {}
+
+		Stats stats;
+	};
+
+	// Every box against every other one: O(n²), the reference the others are measured (and checked) against.
+	class BruteForceBroadphase : public Broadphase {
+
+	public:
+		void Add(Id id, const Aabb& box) override;
+		void Move(Id id, const Aabb& box) override;
+		void Remove(Id id) override;
+		void FindPairs(std::vector<Pair>& out) override;
+		const char* Name() const override { return "brute force"; }
+
+	private:
+		std::vector<Aabb> boxes;
+		std::vector<Id> ids;
+		std::vector<size_t> slots;	// By id: index into boxes and ids.
+	};
+
+	// Every broadphase there is, to pick one at runtime.
+	enum class BroadphaseType {
+		BruteForce,
+		SweepAndPrune,
+		DynamicTree,
+		SpatialHash
+	};
+
+	const BroadphaseType BroadphaseTypes[] = { BroadphaseType::BruteForce, BroadphaseType::SweepAndPrune, BroadphaseType::DynamicTree,
+		BroadphaseType::SpatialHash };
+
+	// With the default settings for each.
+	std::unique_ptr<Broadphase> CreateBroadphase(BroadphaseType type);
+}
+
+#endif
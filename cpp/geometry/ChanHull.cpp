@@ -0,0 +1,199 @@
+#include "ChanHull.h"
+
+#include "MonotoneChain.h"
+#include "Predicates.h"
+#include "TaskPool.h"
+
+namespace Geometry {
+
+	namespace {
+
+		// First guess at the hull size; every failed round squares it. Hulls of a few dozen vertices finish in one round.
+		const size_t FirstGuess = 64;
+
+		// Points per mini-hull building task.
+		const size_t PointsPerTask = 32768;
+
+		/* Whether b is a better next wrapping vertex from p than a: b is clockwise of p -> a, or in the same
+		direction but farther (so collinear points are skipped). p itself is never a candidate.
+		*/
+		bool Better(const Point2D& p, const Point2D& a, const Point2D& b) {
+			if (b == p) {
+				return false;
+			}
+			if (a == p) {
+				return true;
+			}
+			int turn = Predicates::Orient2D(p, a, b);
+			if (turn != 0) {
+				return turn < 0;
+			}
+			// Same direction from p (p is a hull vertex, so a and b cannot lie on both sides of it): b is farther
+			// if a -> b points away from p.
+			return Predicates::DotSign(b, a, a, p) > 0;
+		}
+
+		/* Tangent from p to the counterclockwise polygon q[0, k): the vertex t with all of q on or to the left
+		of p -> t. p is a vertex of the overall hull, so it is never strictly inside q, but it can be one of q's
+		vertices.
+
+		Seen from p the vertices' directions go up from t to the other tangent and back down again, so t is the
+		one vertex where the sequence turns from falling to rising. The binary search below finds it by looking
+		at whether q[c] is on a rising edge and whether it is clockwise of q[0]. Degenerate inputs (p on a vertex,
+		edges lined up with p) can leave it a vertex or two off, which the walk at the end fixes; since the order
+		only has the one minimum, walking downhill from anywhere ends at t.
+		*/
+		size_t Tangent(const Point2D* q, size_t k, const Point2D& p) {
+			if (k == 1) {
+				return 0;
+			}
+
+			auto rising = [&](size_t i) { return Predicates::Orient2D(p, q[i], q[i + 1 == k ? 0 : i + 1]) > 0; };
+
+			size_t t = 0;
+			bool rising_first = rising(0);
+			if (!rising_first || rising(k - 1)) {
+				size_t lo = 1;
+				size_t hi = k - 1;
+				while (lo < hi) {
+					size_t c = (lo + hi) / 2;
+					bool rising_c = rising(c);
+					bool after_first = Predicates::Orient2D(p, q[0], q[c]) > 0;
+					// If q[0] is on the rising run, t comes after the falling run and after the part of the rising run
+					// that is still above q[0]; otherwise t comes after the part of the falling run below q[0].
+					bool past = rising_first ? (!rising_c || after_first) : (!rising_c && !after_first);
+					if (past) {
+						lo = c + 1;
+					}
+					else {
+						hi = c;
+					}
+				}
+				t = lo;
+			}
+
+			for (size_t next = t + 1 == k ? 0 : t + 1; Better(p, q[t], q[next]); next = t + 1 == k ? 0 : t + 1) {
+				t = next;
+			}
+			for (size_t prev = t == 0 ? k - 1 : t - 1; Better(p, q[t], q[prev]); prev = t == 0 ? k - 1 : t - 1) {
+				t = prev;
+			}
+			return t;
+		}
+
+		// One round: the points in groups of m, and each group's hull at hulls + begin + group (room for m + 1).
+		struct Round {
+			size_t m;
+			size_t groups;
+			std::vector<size_t> offset;
+			std::vector<size_t> size;
+		};
+
+		void BuildGroups(std::vector<Point2D>& work, std::vector<Point2D>& hulls, Round& round, size_t first, size_t last) {
+			const size_t n = work.size();
+			for (size_t g = first; g < last; g++) {
+				size_t begin = g * round.m;
+				size_t count = n - begin < round.m ? n - begin : round.m;
+				round.offset[g] = begin + g;
+				round.size[g] = MonotoneChain::GetConvexHull(work.data() + begin, count, hulls.data() + begin + g);
+			}
+		}
+
+		/* Gift wrapping over the mini-hulls, at most round.m steps. Returns false if the hull did not close,
+		i.e. it has more than m vertices.
+		*/
+		bool Wrap(const std::vector<Point2D>& hulls, const Round& round, const Point2D& start, std::vector<Point2D>& hull) {
+			hull.clear();
+			hull.push_back(start);
+
+			Point2D p = start;
+			for (size_t step = 0; step < round.m; step++) {
+				Point2D next = p;
+				for (size_t g = 0; g < round.groups; g++) {
+					const Point2D* q = hulls.data() + round.offset[g];
+					const Point2D& candidate = q[Tangent(q, round.size[g], p)];
+					if (Better(p, next, candidate)) {
+						next = candidate;
+					}
+				}
+
+				// Back at the start, or nothing but p itself (every point is the same).
+				if (next == p || next == start) {
+					return true;
+				}
+				hull.push_back(next);
+				p = next;
+			}
+			return false;
+		}
+
+		std::vector<Point2D> Chan(const std::vector<Point2D>& points, TaskPool* pool) {
+			std::vector<Point2D> hull;
+			const size_t n = points.size();
+			if (n == 0) {
+				return hull;
+			}
+
+			// The wrap starts at the lowest-x point, which is where the hull has to start anyway.
+			Point2D start = points[0];
+			for (size_t i = 1; i < n; i++) {
+				const Point2D& p = points[i];
+				if (p.x < start.x || (p.x == start.x && p.y < start.y)) {
+					start = p;
+				}
+			}
+
+			// Sorting a group scrambles it, but any split into groups of m works, so one working copy does for every round.
+			std::vector<Point2D> work(points);
+			std::vector<Point2D> hulls;
+			Round round;
+
+			for (size_t guess = FirstGuess;;) {
+				const size_t count = work.size();
+				round.m = guess < count ? guess : count;
+				round.groups = (count + round.m - 1) / round.m;
+				round.offset.resize(round.groups);
+				round.size.resize(round.groups);
+				hulls.resize(count + round.groups);
+
+				const size_t groups_per_task = PointsPerTask / round.m + 1;
+				if (pool && round.groups > groups_per_task) {
+					TaskGroup group(*pool);
+					for (size_t first = 0; first < round.groups; first += groups_per_task) {
+						size_t last = round.groups - first < groups_per_task ? round.groups : first + groups_per_task;
+						group.Run([&, first, last]() { BuildGroups(work, hulls, round, first, last); });
+					}
+					group.Wait();
+				}
+				else {
+					BuildGroups(work, hulls, round, 0, round.groups);
+				}
+
+				// With a single group the wrap cannot run out of steps, so this always ends.
+				if (Wrap(hulls, round, start, hull)) {
+					return hull;
+				}
+
+				// A point inside its group's hull is inside the whole hull too, so the next round only needs the
+				// mini-hull vertices. On dense clouds that drops most of the input after the first round.
+				size_t kept = 0;
+				for (size_t g = 0; g < round.groups; g++) {
+					const Point2D* q = hulls.data() + round.offset[g];
+					for (size_t i = 0; i < round.size[g]; i++) {
+						work[kept++] = q[i];
+					}
+				}
+				work.resize(kept);
+				guess = guess < kept / guess ? guess * guess : kept;
+			}
+		}
+	}
+
+	std::vector<Point2D> ChanHull::GetConvexHull(const std::vector<Point2D>& points) {
+		return Chan(points, nullptr);
+	}
+
+	std::vector<Point2D> ChanHull::GetConvexHull(const std::vector<Point2D>& points, TaskPool& pool) {
+		return Chan(points, &pool);
+	}
+}
@@ -0,0 +1,35 @@
+#ifndef _GEOMETRY_CHANHULL_H
+#define _GEOMETRY_CHANHULL_H
+#pragma once
+
+#include <vector>
+
+#include "Point2D.h"
+
+namespace Geometry {
+
+	class TaskPool;
+
+	/* Chan's algorithm: O(n log h), for inputs with millions of points but only a few dozen hull vertices.
+
+	Guess a hull size m, split the points into groups of m, and build each group's hull with the monotone chain
+	(O(n log m) in total; the groups are independent, so this is what runs in parallel). Then gift-wrap the whole
+	set starting from the lowest-x point: every step asks each mini-hull for its tangent from the current vertex,
+	a binary search in O(log m), and takes the most clockwise answer. If the wrap has not closed after m steps the
+	guess was too small, so square it and start over with just the mini-hull vertices (nothing else can be on the
+	hull). The guesses go 64, 4096, 2^24, ... and the total stays O(n log h).
+
+	Same contract as MonotoneChain and QuickHull: counterclockwise (y up), starting at the lowest-x point,
+	no collinear points or duplicates.
+	*/
+	class ChanHull {
+
+	public:
+		static std::vector<Point2D> GetConvexHull(const std::vector<Point2D>& points);
+
+		// Builds the mini-hulls of each round as tasks on the pool; the wrapping itself stays on the calling thread.
+		static std::vector<Point2D> GetConvexHull(const std::vector<Point2D>& points, TaskPool& pool);
+	};
+}
+
+#endif
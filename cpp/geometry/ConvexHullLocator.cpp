@@ -0,0 +1,68 @@
+#include "ConvexHullLocator.h"
+
+#include <cmath>
+
+#include "HullMath.h"
+#include "Predicates.h"
+
+namespace Geometry {
+
+	ConvexHullLocator::ConvexHullLocator() : bounds(Aabb{ Point2D{ 0, 0 }, Point2D{ 0, 0 } }) {}
+
+	ConvexHullLocator::ConvexHullLocator(const std::vector<Point2D>& hull) : ConvexHullLocator() {
+		Reset(hull.data(), hull.size());
+	}
+
+	ConvexHullLocator::ConvexHullLocator(const Point2D* hull, size_t n) : ConvexHullLocator() {
+		Reset(hull, n);
+	}
+
+	void ConvexHullLocator::Reset(const Point2D* hull, size_t n) {
+		vertices.assign(hull, hull + n);
+		spokes.resize(n);
+		for (size_t i = 0; i < n; i++) {
+			spokes[i] = hull[i] - hull[0];
+		}
+		bounds = n > 0 ? BoundsOf(hull, n) : Aabb{ Point2D{ 0, 0 }, Point2D{ 0, 0 } };
+	}
+
+	/* Predicates::Orient2D(pivot, vertices[i], point), with the differences already taken, but as a double
+	whose sign is the answer: the plain determinant when the filter can vouch for its sign, the exact sign if not.
+	*/
+	double ConvexHullLocator::Side(size_t i, const Point2D& offset, const Point2D& point) const {
+		double left = spokes[i].x * offset.y;
+		double right = spokes[i].y * offset.x;
+		double det = left - right;
+		if (std::fabs(det) <= Predicates::OrientErrorBound * (std::fabs(left) + std::fabs(right))) {
+			return Predicates::Orient2D(vertices[0], vertices[i], point);
+		}
+		return det;
+	}
+
+	/* The same search as HullMath::ContainsPoint, as halving steps of fixed count: which way a step goes is
+	picked with a select rather than a branch, so random queries do not pay a misprediction per level.
+	*/
+	bool ConvexHullLocator::Contains(const Point2D& point) const {
+		size_t n = vertices.size();
+		if (n < 3) {
+			return HullMath::ContainsPoint(vertices.data(), n, point);
+		}
+		if (point.x < bounds.min.x || point.x > bounds.max.x || point.y < bounds.min.y || point.y > bounds.max.y) {
+			return false;
+		}
+
+		Point2D offset = point - vertices[0];
+		if (Side(1, offset, point) < 0 || Side(n - 1, offset, point) > 0) {
+			return false;
+		}
+		// The last of spokes 1 to n - 2 the point is not right of.
+		size_t low = 1;
+		size_t count = n - 2;
+		while (count > 1) {
+			size_t half = count / 2;
+			low = Side(low + half, offset, point) >= 0 ? low + half : low;
+			count -= half;
+		}
+		return Predicates::Orient2D(vertices[low], vertices[low + 1], point) >= 0;
+	}
+}
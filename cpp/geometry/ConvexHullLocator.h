@@ -0,0 +1,47 @@
+#ifndef _GEOMETRY_CONVEXHULLLOCATOR_H
+#define _GEOMETRY_CONVEXHULLLOCATOR_H
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Aabb.h"
+#include "Point2D.h"
+
+namespace Geometry {
+
+	/* HullMath::ContainsPoint for one hull asked about many points. The hull is copied once, with its bounds
+	and the fan's spokes (every vertex minus the first, the pivot) worked out ahead.
+
+	A query outside the bounds is done after four compares. Otherwise the point minus the pivot is taken once,
+	and each step of the wedge search is two products against a stored spoke, with the same error bound as
+	Predicates::Orient2D (the spokes are the very differences it would round); only steps too close to call go
+	to the exact predicate. The steps do not branch on which way they go, which is what the plain search loses
+	most of its time to on random queries. Answers are the same as ContainsPoint's, boundary included.
+	*/
+	class ConvexHullLocator {
+
+	public:
+		ConvexHullLocator();
+
+		// Same contract as HullMath::ContainsPoint.
+		explicit ConvexHullLocator(const std::vector<Point2D>& hull);
+		ConvexHullLocator(const Point2D* hull, size_t n);
+
+		void Reset(const Point2D* hull, size_t n);
+
+		bool Contains(const Point2D& point) const;
+
+		size_t Size() const { return vertices.size(); }
+		const Aabb& Bounds() const { return bounds; }
+
+	private:
+		std::vector<Point2D> vertices;
+		std::vector<Point2D> spokes;	// vertices[i] - vertices[0].
+		Aabb bounds;
+
+		double Side(size_t i, const Point2D& offset, const Point2D& point) const;
+	};
+}
+
+#endif
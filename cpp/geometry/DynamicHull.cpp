@@ -0,0 +1,387 @@
+#include "DynamicHull.h"
+
+#include <algorithm>
+
+#include "Predicates.h"
+
+namespace Geometry {
+
+	namespace {
+
+		bool Less(const Point2D& a, const Point2D& b) {
+			return a.x < b.x || (a.x == b.x && a.y < b.y);
+		}
+
+		/* Side 0 is the upper hull as is. Side 1 is the lower hull, handled as the upper hull of the points turned
+		by 180 degrees: that negates every point and swaps left and right.
+		*/
+		Point2D InFrame(const Point2D& point, int side) {
+			return side == 0 ? point : Point2D{ -point.x, -point.y };
+		}
+	}
+
+	DynamicHull::DynamicHull() : root(Nil), seed(2463534242u), count(0), changed(false) {
+	}
+
+	/* The leaves go in left to right, and the inner node between two neighbours gets its random priority at once,
+	so the treap can be built like a Cartesian tree: keep the right spine on a stack, pop what has a lower
+	priority than the new inner node and hang it under it. Then one post-order pass finds all the bridges; a
+	node's bridges cost about its height, and those heights add up to O(n).
+	*/
+	DynamicHull::DynamicHull(const std::vector<Point2D>& points) : root(Nil), seed(2463534242u), count(points.size()), changed(true) {
+		slots.reserve(points.size());
+		for (const Point2D& point : points) {
+			slots.push_back(Slot{ point, 1, true });
+		}
+
+		std::vector<Point2D> sorted(points);
+		std::sort(sorted.begin(), sorted.end(), Less);
+		nodes.reserve(2 * sorted.size());
+
+		std::vector<size_t> spine;
+		size_t last_leaf = Nil;
+		for (size_t i = 0; i < sorted.size(); i++) {
+			if (i > 0 && sorted[i] == sorted[i - 1]) {
+				nodes[last_leaf].points++;
+				continue;
+			}
+
+			size_t leaf = NewNode();
+			nodes[leaf].left = nodes[leaf].right = Nil;
+			nodes[leaf].points = 1;
+			nodes[leaf].min = nodes[leaf].max = sorted[i];
+			if (last_leaf == Nil) {
+				nodes[leaf].parent = Nil;
+				root = last_leaf = leaf;
+				continue;
+			}
+
+			size_t inner = NewNode();
+			nodes[inner].priority = Random();
+			size_t below = last_leaf;
+			while (!spine.empty() && nodes[spine.back()].priority < nodes[inner].priority) {
+				below = spine.back();
+				spine.pop_back();
+			}
+
+			nodes[inner].parent = spine.empty() ? Nil : spine.back();
+			if (spine.empty()) {
+				root = inner;
+			}
+			else {
+				nodes[spine.back()].right = inner;
+			}
+			nodes[inner].left = below;
+			nodes[inner].right = leaf;
+			nodes[below].parent = nodes[leaf].parent = inner;
+			spine.push_back(inner);
+			last_leaf = leaf;
+		}
+
+		if (root != Nil) {
+			UpdateSubtree(root);
+		}
+	}
+
+	size_t DynamicHull::NewNode() {
+		if (!free_nodes.empty()) {
+			size_t node = free_nodes.back();
+			free_nodes.pop_back();
+			return node;
+		}
+		nodes.push_back(Node());
+		return nodes.size() - 1;
+	}
+
+	void DynamicHull::FreeNode(size_t node) {
+		free_nodes.push_back(node);
+	}
+
+	// xorshift32, plenty for treap priorities.
+	uint32_t DynamicHull::Random() {
+		seed ^= seed << 13;
+		seed ^= seed >> 17;
+		seed ^= seed << 5;
+		return seed;
+	}
+
+	// The leaf holding point, or the one next to where it would go.
+	size_t DynamicHull::FindLeaf(const Point2D& point) const {
+		size_t node = root;
+		while (!IsLeaf(node)) {
+			const Node& n = nodes[node];
+			node = Less(nodes[n.left].max, point) ? n.right : n.left;
+		}
+		return node;
+	}
+
+	// Puts by where node was under node's parent (or at the root).
+	void DynamicHull::Replace(size_t node, size_t by) {
+		size_t parent = nodes[node].parent;
+		nodes[by].parent = parent;
+		if (parent == Nil) {
+			root = by;
+		}
+		else if (nodes[parent].left == node) {
+			nodes[parent].left = by;
+		}
+		else {
+			nodes[parent].right = by;
+		}
+	}
+
+	// Rotates node above its parent. Only inner nodes move, the leaves keep their order.
+	void DynamicHull::Rotate(size_t node) {
+		size_t parent = nodes[node].parent;
+		Replace(parent, node);
+		if (nodes[parent].left == node) {
+			size_t moved = nodes[node].right;
+			nodes[parent].left = moved;
+			nodes[moved].parent = parent;
+			nodes[node].right = parent;
+		}
+		else {
+			size_t moved = nodes[node].left;
+			nodes[parent].right = moved;
+			nodes[moved].parent = parent;
+			nodes[node].left = parent;
+		}
+		nodes[parent].parent = node;
+	}
+
+	void DynamicHull::Update(size_t node) {
+		Node& n = nodes[node];
+		n.min = nodes[n.left].min;
+		n.max = nodes[n.right].max;
+		n.bridge[0] = FindBridge(node, 0);
+		n.bridge[1] = FindBridge(node, 1);
+	}
+
+	void DynamicHull::UpdateSubtree(size_t node) {
+		if (!IsLeaf(node)) {
+			UpdateSubtree(nodes[node].left);
+			UpdateSubtree(nodes[node].right);
+			Update(node);
+		}
+	}
+
+	/* Finds the upper bridge between the node's children in the given frame: x walks down the left child and
+	y down the right one, and every step discards half of one of them. At each step the bridge of x (a, b) is
+	an edge of x's hull and the wanted point p is either at or left of a, or at or right of b; same for y's
+	bridge (c, d) and the wanted point q.
+
+	 - c on or above the line ab: p cannot be right of a, because the tangent there would pass below c.
+	 - b on or above the line cd: likewise q cannot be left of d.
+	 - neither: the two lines cross, and which side of the split between the children they cross on tells
+	   whether p is right of b (crossing left of the split) or q is left of c (crossing right of it).
+
+	Once one side is down to a leaf, only the tangent from that point to the other side is left to find.
+	*/
+	DynamicHull::Bridge DynamicHull::FindBridge(size_t node, int side) const {
+		const Node& n = nodes[node];
+		size_t x = side == 0 ? n.left : n.right;
+		size_t y = side == 0 ? n.right : n.left;
+		const Point2D split = side == 0 ? nodes[y].min : InFrame(nodes[y].max, 1);
+
+		while (true) {
+			const Node& nx = nodes[x];
+			const Node& ny = nodes[y];
+			bool x_leaf = IsLeaf(x);
+			bool y_leaf = IsLeaf(y);
+			if (x_leaf && y_leaf) {
+				return Bridge{ InFrame(nx.min, side), InFrame(ny.min, side) };
+			}
+
+			size_t x_left = side == 0 ? nx.left : nx.right;
+			size_t x_right = side == 0 ? nx.right : nx.left;
+			size_t y_left = side == 0 ? ny.left : ny.right;
+			size_t y_right = side == 0 ? ny.right : ny.left;
+
+			if (x_leaf) {
+				const Point2D p = InFrame(nx.min, side);
+				const Bridge& cd = ny.bridge[side];
+				y = Predicates::Orient2D(cd.p, cd.q, p) < 0 ? y_left : y_right;
+				continue;
+			}
+			if (y_leaf) {
+				const Point2D q = InFrame(ny.min, side);
+				const Bridge& ab = nx.bridge[side];
+				x = Predicates::Orient2D(ab.p, ab.q, q) < 0 ? x_right : x_left;
+				continue;
+			}
+
+			const Point2D& a = nx.bridge[side].p;
+			const Point2D& b = nx.bridge[side].q;
+			const Point2D& c = ny.bridge[side].p;
+			const Point2D& d = ny.bridge[side].q;
+			if (Predicates::Orient2D(a, b, c) >= 0) {
+				x = x_left;
+			}
+			else if (Predicates::Orient2D(c, d, b) >= 0) {
+				y = y_right;
+			}
+			else if (Predicates::CompareCrossing(a, b, c, d, split) < 0) {
+				x = x_right;
+			}
+			else {
+				y = y_left;
+			}
+		}
+	}
+
+	void DynamicHull::Add(const Point2D& point) {
+		changed = true;
+		if (root == Nil) {
+			root = NewNode();
+			Node& leaf = nodes[root];
+			leaf.parent = leaf.left = leaf.right = Nil;
+			leaf.points = 1;
+			leaf.min = leaf.max = point;
+			return;
+		}
+
+		size_t near = FindLeaf(point);
+		if (nodes[near].min == point) {
+			nodes[near].points++;
+			return;
+		}
+
+		size_t leaf = NewNode();
+		size_t inner = NewNode();
+		nodes[leaf].left = nodes[leaf].right = Nil;
+		nodes[leaf].points = 1;
+		nodes[leaf].min = nodes[leaf].max = point;
+
+		Replace(near, inner);
+		nodes[inner].priority = Random();
+		nodes[inner].left = Less(point, nodes[near].min) ? leaf : near;
+		nodes[inner].right = Less(point, nodes[near].min) ? near : leaf;
+		nodes[leaf].parent = nodes[near].parent = inner;
+
+		// Restore the heap order on the priorities. A node rotated below the new one only has finished subtrees
+		// under it, so its bridges can be redone right away; the new node and its ancestors follow at the end.
+		while (nodes[inner].parent != Nil && nodes[nodes[inner].parent].priority < nodes[inner].priority) {
+			size_t parent = nodes[inner].parent;
+			Rotate(inner);
+			Update(parent);
+		}
+		for (size_t node = inner; node != Nil; node = nodes[node].parent) {
+			Update(node);
+		}
+	}
+
+	void DynamicHull::Remove(const Point2D& point) {
+		changed = true;
+		size_t leaf = FindLeaf(point);
+		if (--nodes[leaf].points > 0) {
+			return;
+		}
+
+		size_t parent = nodes[leaf].parent;
+		FreeNode(leaf);
+		if (parent == Nil) {
+			root = Nil;
+			return;
+		}
+
+		// The parent only separated this leaf from its sibling, so the sibling takes its place.
+		size_t sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+		size_t above = nodes[parent].parent;
+		Replace(parent, sibling);
+		FreeNode(parent);
+		for (size_t node = above; node != Nil; node = nodes[node].parent) {
+			Update(node);
+		}
+	}
+
+	DynamicHull::Handle DynamicHull::Insert(const Point2D& point) {
+		uint32_t slot;
+		if (free_slots.empty()) {
+			slot = (uint32_t)slots.size();
+			slots.push_back(Slot{ point, 0, false });
+		}
+		else {
+			slot = free_slots.back();
+			free_slots.pop_back();
+		}
+		// Generations start at 1 and skip 0 when they wrap, so a default Handle never matches.
+		Slot& entry = slots[slot];
+		entry.generation = entry.generation + 1 == 0 ? 1 : entry.generation + 1;
+		entry.position = point;
+		entry.in = true;
+		count++;
+		Add(point);
+		return Handle(slot, entry.generation);
+	}
+
+	bool DynamicHull::Erase(Handle handle) {
+		if (!Valid(handle)) {
+			return false;
+		}
+		Slot& entry = slots[handle.slot];
+		Remove(entry.position);
+		entry.in = false;
+		free_slots.push_back(handle.slot);
+		count--;
+		return true;
+	}
+
+	bool DynamicHull::Move(Handle handle, const Point2D& point) {
+		if (!Valid(handle)) {
+			return false;
+		}
+		Slot& entry = slots[handle.slot];
+		if (entry.position == point) {
+			return true;
+		}
+		Remove(entry.position);
+		entry.position = point;
+		Add(point);
+		return true;
+	}
+
+	/* Appends the upper hull vertices of the node's subtree (in the frame) from lo to hi, which are both
+	vertices of that hull. Every call emits at least one vertex, so this is O(h log n).
+	*/
+	void DynamicHull::Emit(size_t node, int side, const Point2D& lo, const Point2D& hi, std::vector<Point2D>& out) const {
+		const Node& n = nodes[node];
+		if (IsLeaf(node)) {
+			out.push_back(InFrame(n.min, side));
+			return;
+		}
+
+		const Bridge& bridge = n.bridge[side];
+		if (!Less(bridge.p, lo)) {
+			Emit(side == 0 ? n.left : n.right, side, lo, Less(hi, bridge.p) ? hi : bridge.p, out);
+		}
+		if (!Less(hi, bridge.q)) {
+			Emit(side == 0 ? n.right : n.left, side, Less(lo, bridge.q) ? bridge.q : lo, hi, out);
+		}
+	}
+
+	DynamicHull::View DynamicHull::Hull() {
+		if (changed) {
+			changed = false;
+			hull.clear();
+			if (root != Nil) {
+				const Node& top = nodes[root];
+
+				// The lower hull comes out from the highest point to the lowest (in the turned frame it is the upper
+				// hull from left to right), so it is read backwards.
+				scratch.clear();
+				Emit(root, 1, InFrame(top.max, 1), InFrame(top.min, 1), scratch);
+				for (size_t i = scratch.size(); i-- > 0;) {
+					hull.push_back(InFrame(scratch[i], 1));
+				}
+
+				// The upper hull goes lowest to highest, also read backwards, without the two points already there.
+				scratch.clear();
+				Emit(root, 0, top.min, top.max, scratch);
+				for (size_t i = scratch.size() - 1; i-- > 1;) {
+					hull.push_back(scratch[i]);
+				}
+			}
+		}
+		return View(hull.data(), hull.data() + hull.size());
+	}
+}
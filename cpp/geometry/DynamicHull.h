@@ -0,0 +1,155 @@
+#ifndef _GEOMETRY_DYNAMICHULL_H
+#define _GEOMETRY_DYNAMICHULL_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace Geometry {
+
+	/* Convex hull of a changing point set: insert, erase and move in O(log² n), no full recompute.
+
+	This is Overmars and van Leeuwen's structure with the hulls kept implicit. The points sit in the leaves
+	of a balanced search tree ordered by x (then y), and every inner node stores the two bridges between its
+	children: the upper bridge (the hull edge that crosses from the left child's upper hull to the right child's)
+	and the lower one. That is all the hull information there is; a node's upper hull is its left child's upper
+	hull up to the bridge, then the right child's from the bridge on.
+
+	An update only changes the nodes on one root-to-leaf path, and each of their bridges is found again with a
+	simultaneous binary descent through the two children (O(log n) each, O(log² n) per update). The lower bridge
+	uses the same code on the point set turned by 180 degrees. The tree is a treap on the inner nodes, so it stays
+	O(log n) deep in expectation without any rebalancing on erase. Nodes live in one pool and are reused.
+
+	Coinciding points share a leaf (with a count), so the tree only ever holds distinct points.
+
+	Points are held by generational handles, as in PointStore: a slot and the generation it had when the point
+	went in. A slot gets a new generation every time it is reused, so a handle that was erased stops being Valid
+	and Erase and Move turn it away, instead of taking a point that now belongs to someone else out of the tree.
+	*/
+	class DynamicHull {
+
+	public:
+		struct Handle {
+			uint32_t slot;
+			uint32_t generation;	// 0 is never handed out.
+
+			Handle() : slot(0), generation(0) {}
+			Handle(uint32_t slot, uint32_t generation) : slot(slot), generation(generation) {}
+
+			bool operator==(const Handle& other) const { return slot == other.slot && generation == other.generation; }
+			bool operator!=(const Handle& other) const { return !(*this == other); }
+		};
+
+		/* The current hull: counterclockwise (y up), starting at the lowest-x point, no collinear points or
+		duplicates, like the static engines. Valid until the next update.
+		*/
+		class View {
+
+		public:
+			const Point2D* begin() const { return first; }
+			const Point2D* end() const { return last; }
+			size_t size() const { return (size_t)(last - first); }
+			bool empty() const { return first == last; }
+			const Point2D& operator[](size_t i) const { return first[i]; }
+
+		private:
+			friend class DynamicHull;
+			View(const Point2D* first, const Point2D* last) : first(first), last(last) {}
+
+			const Point2D* first;
+			const Point2D* last;
+		};
+
+		DynamicHull();
+
+		/* Starts out with all of points; points[i] is in slot i, AtSlot(i) is its handle. Builds the tree bottom up from the sorted
+		points in O(n log n), much quicker than inserting them one by one.
+		*/
+		explicit DynamicHull(const std::vector<Point2D>& points);
+
+		Handle Insert(const Point2D& point);
+
+		// False (and nothing happens) if the handle is stale.
+		bool Erase(Handle handle);
+
+		// Erase and insert in one go; the handle stays the same. Cheap if the point does not actually move.
+		// False (and nothing happens) if the handle is stale.
+		bool Move(Handle handle, const Point2D& point);
+
+		bool Valid(Handle handle) const {
+			return handle.slot < slots.size() && slots[handle.slot].in && slots[handle.slot].generation == handle.generation;
+		}
+
+		// The live handle in a slot; not valid if the slot is free.
+		Handle AtSlot(uint32_t slot) const { return Handle(slot, slots[slot].generation); }
+
+		// Of a valid handle.
+		const Point2D& Position(Handle handle) const { return slots[handle.slot].position; }
+		size_t Size() const { return count; }
+
+		/* Walks the bridges to collect the hull, O(h log n), but only if something changed since the last call.
+		*/
+		View Hull();
+
+	private:
+		static const size_t Nil = (size_t)-1;
+
+		// Both bridges are kept in the frame they were found in: the lower one with its points negated.
+		struct Bridge {
+			Point2D p;		// On the left child's hull; the leftmost point on the bridge line.
+			Point2D q;		// On the right child's hull; the rightmost point on the bridge line.
+		};
+
+		struct Node {
+			size_t parent;
+			size_t left;		// Nil for leaves.
+			size_t right;
+			uint32_t priority;
+			size_t points;		// Leaves only: how many handles sit on this point.
+			Point2D min;		// Lowest and highest point in the subtree (the point itself for leaves).
+			Point2D max;
+			Bridge bridge[2];	// Upper, lower.
+		};
+
+		std::vector<Node> nodes;
+		std::vector<size_t> free_nodes;
+		size_t root;
+		uint32_t seed;
+
+		struct Slot {
+			Point2D position;
+			uint32_t generation;
+			bool in;				// False while free.
+		};
+
+		std::vector<Slot> slots;
+		std::vector<uint32_t> free_slots;
+		size_t count;
+
+		std::vector<Point2D> hull;
+		std::vector<Point2D> scratch;
+		bool changed;
+
+		size_t NewNode();
+		void FreeNode(size_t node);
+		uint32_t Random();
+
+		bool IsLeaf(size_t node) const { return nodes[node].left == Nil; }
+		size_t FindLeaf(const Point2D& point) const;
+		void Replace(size_t node, size_t by);
+		void Rotate(size_t node);
+		void Update(size_t node);
+		void UpdateSubtree(size_t node);
+
+		void Add(const Point2D& point);
+		void Remove(const Point2D& point);
+
+		Bridge FindBridge(size_t node, int side) const;
+		void Emit(size_t node, int side, const Point2D& lo, const Point2D& hi, std::vector<Point2D>& out) const;
+	};
+}
+
+#endif
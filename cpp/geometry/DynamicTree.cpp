@@ -0,0 +1,384 @@
+#include "DynamicTree.h"
+
+#include <algorithm>
+
+namespace Geometry {
+
+	namespace {
+
+		// A leaf's fat box reaches this many times its last move further in the direction it moved.
+		const double Stretch = 2.0;
+
+		bool NearerThan(const DynamicTree::RayHit& a, const DynamicTree::RayHit& b) {
+			return a.t < b.t;
+		}
+
+		/* Slab test: where the segment origin + t * direction, 0 <= t <= max_t, enters box. On an axis the
+		direction has no part in, the origin has to be within the box's extent.
+		*/
+		bool Enters(const Point2D& origin, const Point2D& direction, double max_t, const Aabb& box, double& t) {
+			double enter = 0;
+			double leave = max_t;
+			const double o[2] = { origin.x, origin.y };
+			const double d[2] = { direction.x, direction.y };
+			const double lo[2] = { box.min.x, box.min.y };
+			const double hi[2] = { box.max.x, box.max.y };
+			for (int axis = 0; axis < 2; axis++) {
+				if (d[axis] == 0) {
+					if (o[axis] < lo[axis] || o[axis] > hi[axis]) {
+						return false;
+					}
+					continue;
+				}
+				double near_t = (lo[axis] - o[axis]) / d[axis];
+				double far_t = (hi[axis] - o[axis]) / d[axis];
+				if (near_t > far_t) {
+					std::swap(near_t, far_t);
+				}
+				enter = std::max(enter, near_t);
+				leave = std::min(leave, far_t);
+				if (enter > leave) {
+					return false;
+				}
+			}
+			t = enter;
+			return true;
+		}
+	}
+
+	DynamicTree::DynamicTree(double margin) : margin(margin), root(Nil), reinserts(0), last_reinserts(0) {}
+
+	int32_t DynamicTree::NewNode() {
+		if (!free_nodes.empty()) {
+			int32_t node = free_nodes.back();
+			free_nodes.pop_back();
+			return node;
+		}
+		nodes.push_back(Node());
+		return (int32_t)nodes.size() - 1;
+	}
+
+	void DynamicTree::FreeNode(int32_t node) {
+		free_nodes.push_back(node);
+	}
+
+	void DynamicTree::Update(int32_t node) {
+		Node& n = nodes[node];
+		n.box = Union(nodes[n.left].box, nodes[n.right].box);
+		n.height = 1 + std::max(nodes[n.left].height, nodes[n.right].height);
+	}
+
+	/* Surface area heuristic, walked down from the root. Putting the leaf next to a node costs the perimeter of
+	the new parent (the union of the two), plus what every ancestor's box grows by on the way down; go on into
+	the child that would be cheaper, and stop where neither child beats pairing with the node itself.
+	*/
+	int32_t DynamicTree::FindSibling(const Aabb& box) const {
+		int32_t node = root;
+		double inherited = 0;
+		while (nodes[node].left != Nil) {
+			const Node& n = nodes[node];
+			double direct = Perimeter(Union(n.box, box));
+			double below = inherited + direct - Perimeter(n.box);
+			const Node& left = nodes[n.left];
+			const Node& right = nodes[n.right];
+			double left_cost = below + Perimeter(Union(left.box, box)) - (left.left == Nil ? 0 : Perimeter(left.box));
+			double right_cost = below + Perimeter(Union(right.box, box)) - (right.left == Nil ? 0 : Perimeter(right.box));
+			if (direct + inherited <= left_cost && direct + inherited <= right_cost) {
+				break;
+			}
+			node = left_cost < right_cost ? n.left : n.right;
+			inherited = below;
+		}
+		return node;
+	}
+
+	void DynamicTree::InsertLeaf(int32_t leaf) {
+		if (root == Nil) {
+			root = leaf;
+			nodes[leaf].parent = Nil;
+			return;
+		}
+
+		int32_t sibling = FindSibling(nodes[leaf].box);
+		int32_t parent = NewNode();
+		int32_t grandparent = nodes[sibling].parent;
+		nodes[parent].parent = grandparent;
+		nodes[parent].left = sibling;
+		nodes[parent].right = leaf;
+		nodes[sibling].parent = parent;
+		nodes[leaf].parent = parent;
+		if (grandparent == Nil) {
+			root = parent;
+		}
+		else if (nodes[grandparent].left == sibling) {
+			nodes[grandparent].left = parent;
+		}
+		else {
+			nodes[grandparent].right = parent;
+		}
+		Update(parent);
+		Refit(parent);
+	}
+
+	// The leaf's parent goes with it; the sibling takes the parent's place.
+	void DynamicTree::RemoveLeaf(int32_t leaf) {
+		if (leaf == root) {
+			root = Nil;
+			return;
+		}
+
+		int32_t parent = nodes[leaf].parent;
+		int32_t grandparent = nodes[parent].parent;
+		int32_t sibling = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+		nodes[sibling].parent = grandparent;
+		FreeNode(parent);
+		if (grandparent == Nil) {
+			root = sibling;
+			return;
+		}
+		if (nodes[grandparent].left == parent) {
+			nodes[grandparent].left = sibling;
+		}
+		else {
+			nodes[grandparent].right = sibling;
+		}
+		Refit(grandparent);
+	}
+
+	// Boxes and heights from node up to the root, rotating wherever the heights got lopsided.
+	void DynamicTree::Refit(int32_t node) {
+		while (node != Nil) {
+			node = Balance(node);
+			Update(node);
+			node = nodes[node].parent;
+		}
+	}
+
+	int32_t DynamicTree::Balance(int32_t node) {
+		const Node& n = nodes[node];
+		if (n.left == Nil) {
+			return node;
+		}
+		int32_t lean = nodes[n.right].height - nodes[n.left].height;
+		if (lean > 1) {
+			return Promote(node, n.right);
+		}
+		if (lean < -1) {
+			return Promote(node, n.left);
+		}
+		return node;
+	}
+
+	/* Rotation: the taller child takes node's place, node becomes its child. Of the child's own two children
+	the taller one stays with it and the shorter one moves over to node, where the child used to be.
+	*/
+	int32_t DynamicTree::Promote(int32_t node, int32_t child) {
+		int32_t parent = nodes[node].parent;
+		int32_t left = nodes[child].left;
+		int32_t right = nodes[child].right;
+		int32_t keep = nodes[left].height > nodes[right].height ? left : right;
+		int32_t give = keep == left ? right : left;
+
+		nodes[child].parent = parent;
+		if (parent == Nil) {
+			root = child;
+		}
+		else if (nodes[parent].left == node) {
+			nodes[parent].left = child;
+		}
+		else {
+			nodes[parent].right = child;
+		}
+
+		if (nodes[node].left == child) {
+			nodes[node].left = give;
+		}
+		else {
+			nodes[node].right = give;
+		}
+		nodes[give].parent = node;
+		nodes[child].left = node;
+		nodes[child].right = keep;
+		nodes[node].parent = child;
+
+		Update(node);
+		Update(child);
+		return child;
+	}
+
+	void DynamicTree::MarkChanged(Id id) {
+		if (!changed[id]) {
+			changed[id] = 1;
+			changed_ids.push_back(id);
+		}
+	}
+
+	void DynamicTree::Add(Id id, const Aabb& box) {
+		if (id >= boxes.size()) {
+			boxes.resize((size_t)id + 1);
+			leaves.resize((size_t)id + 1, Nil);
+			changed.resize((size_t)id + 1, 0);
+		}
+		boxes[id] = box;
+		int32_t leaf = NewNode();
+		nodes[leaf] = Node{ Fatten(box, margin), Nil, Nil, Nil, 0, id };
+		leaves[id] = leaf;
+		InsertLeaf(leaf);
+		MarkChanged(id);
+	}
+
+	void DynamicTree::Move(Id id, const Aabb& box) {
+		Point2D moved = box.min - boxes[id].min;
+		boxes[id] = box;
+		int32_t leaf = leaves[id];
+		if (Contains(nodes[leaf].box, box)) {
+			return;
+		}
+
+		RemoveLeaf(leaf);
+		Aabb fat = Fatten(box, margin);
+		(moved.x < 0 ? fat.min.x : fat.max.x) += Stretch * moved.x;
+		(moved.y < 0 ? fat.min.y : fat.max.y) += Stretch * moved.y;
+		nodes[leaf].box = fat;
+		InsertLeaf(leaf);
+		MarkChanged(id);
+		reinserts++;
+	}
+
+	void DynamicTree::Remove(Id id) {
+		int32_t leaf = leaves[id];
+		RemoveLeaf(leaf);
+		FreeNode(leaf);
+		leaves[id] = Nil;
+		MarkChanged(id);
+	}
+
+	/* Fat boxes prune, and at the leaves decide too if fat is set, the real ones otherwise. Returns the box
+	tests made. Appends to out.
+	*/
+	uint64_t DynamicTree::Collect(const Aabb& region, std::vector<Id>& out, bool fat) const {
+		uint64_t tests = 0;
+		if (root == Nil) {
+			return tests;
+		}
+		stack.clear();
+		stack.push_back(root);
+		while (!stack.empty()) {
+			const Node& n = nodes[stack.back()];
+			stack.pop_back();
+			tests++;
+			if (!Overlaps(n.box, region)) {
+				continue;
+			}
+			if (n.left != Nil) {
+				stack.push_back(n.left);
+				stack.push_back(n.right);
+				continue;
+			}
+			if (fat) {
+				out.push_back(n.id);
+				continue;
+			}
+			tests++;
+			if (Overlaps(boxes[n.id], region)) {
+				out.push_back(n.id);
+			}
+		}
+		return tests;
+	}
+
+	void DynamicTree::Query(const Aabb& region, std::vector<Id>& out) const {
+		out.clear();
+		Collect(region, out, false);
+	}
+
+	/* Pairs with a changed leaf in them are dropped and found again: each changed leaf still in the tree is
+	queried with its fat box, and a pair of two changed leaves is kept from the side with the smaller id. The
+	other pairs' fat boxes are as they were, so they stay. Whatever the real boxes say goes out.
+	*/
+	void DynamicTree::FindPairs(std::vector<Pair>& out) {
+		uint64_t tests = 0;
+		fat_pairs.erase(std::remove_if(fat_pairs.begin(), fat_pairs.end(), [this](const Pair& pair) {
+			return changed[pair.first] || changed[pair.second];
+		}), fat_pairs.end());
+
+		for (Id id : changed_ids) {
+			if (leaves[id] == Nil) {
+				continue;
+			}
+			hits.clear();
+			tests += Collect(nodes[leaves[id]].box, hits, true);
+			for (Id other : hits) {
+				if (other == id || (changed[other] && other < id)) {
+					continue;
+				}
+				fat_pairs.push_back(id < other ? Pair{ id, other } : Pair{ other, id });
+			}
+		}
+		for (Id id : changed_ids) {
+			changed[id] = 0;
+		}
+		changed_ids.clear();
+
+		out.clear();
+		for (const Pair& pair : fat_pairs) {
+			if (Overlaps(boxes[pair.first], boxes[pair.second])) {
+				out.push_back(pair);
+			}
+		}
+		tests += fat_pairs.size();
+
+		stats.box_tests = tests;
+		stats.pairs = out.size();
+		last_reinserts = reinserts;
+		reinserts = 0;
+	}
+
+	void DynamicTree::RayCast(const Point2D& origin, const Point2D& direction, double max_t, std::vector<RayHit>& out) const {
+		out.clear();
+		if (root == Nil) {
+			return;
+		}
+		stack.clear();
+		stack.push_back(root);
+		while (!stack.empty()) {
+			const Node& n = nodes[stack.back()];
+			stack.pop_back();
+			double t;
+			if (!Enters(origin, direction, max_t, n.box, t)) {
+				continue;
+			}
+			if (n.left != Nil) {
+				stack.push_back(n.left);
+				stack.push_back(n.right);
+			}
+			else if (Enters(origin, direction, max_t, boxes[n.id], t)) {
+				out.push_back(RayHit{ n.id, t });
+			}
+		}
+		std::sort(out.begin(), out.end(), NearerThan);
+	}
+
+	int DynamicTree::Height() const {
+		return root == Nil ? -1 : nodes[root].height;
+	}
+
+	double DynamicTree::Cost() const {
+		double cost = 0;
+		if (root == Nil) {
+			return cost;
+		}
+		stack.clear();
+		stack.push_back(root);
+		while (!stack.empty()) {
+			const Node& n = nodes[stack.back()];
+			stack.pop_back();
+			if (n.left != Nil) {
+				cost += Perimeter(n.box);
+				stack.push_back(n.left);
+				stack.push_back(n.right);
+			}
+		}
+		return cost;
+	}
+}
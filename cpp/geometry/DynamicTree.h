@@ -0,0 +1,123 @@
+#ifndef _GEOMETRY_DYNAMICTREE_H
+#define _GEOMETRY_DYNAMICTREE_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Broadphase.h"
+
+namespace Geometry {
+
+	/* Dynamic bounding volume hierarchy: a binary tree of boxes, every box holding its children, the leaves
+	holding the hulls. Whatever does not overlap a node's box cannot overlap anything under it, so a query skips
+	whole subtrees; unlike a grid or a sweep, that works just as well when a few huge hulls sit among many tiny
+	ones.
+
+	Leaves keep a fattened box, the real one grown by the margin (and stretched the way the box last moved), and
+	a move that stays inside it touches nothing in the tree. Only when a box leaves its fat box is the leaf taken
+	out and put back in.
+
+	A new leaf goes next to the sibling that grows the tree's total perimeter the least (the surface area
+	heuristic, with perimeter for area in 2D), looked for along one path down from the root. On the way back
+	up, nodes whose children differ in height by more than one are rotated, so the tree stays within a few
+	levels of balanced whatever order boxes come in.
+
+	The pairs whose fat boxes overlap are kept from frame to frame. Pairs of leaves that stayed put cannot have
+	changed, so FindPairs only queries the tree for leaves that were added or reinserted since, then checks the
+	real boxes of what it has. With most leaves inside their fat boxes, that is a small part of the work of
+	querying every leaf.
+
+	All nodes live in one vector, children by index, freed ones on a free list: no allocation per node, and a
+	traversal walks a single block of memory.
+	*/
+	class DynamicTree : public Broadphase {
+
+	public:
+		// In the units of the boxes; a few frames of movement for things the size of the window's hulls.
+		static constexpr double DefaultMargin = 8.0;
+
+		// Where a ray enters a box, as a multiple of the direction.
+		struct RayHit {
+			Id id;
+			double t;
+		};
+
+		explicit DynamicTree(double margin = DefaultMargin);
+
+		void Add(Id id, const Aabb& box) override;
+		void Move(Id id, const Aabb& box) override;
+		void Remove(Id id) override;
+
+		void FindPairs(std::vector<Pair>& out) override;
+
+		const char* Name() const override { return "dynamic tree"; }
+
+		// Ids whose boxes overlap region. Replaces out.
+		void Query(const Aabb& region, std::vector<Id>& out) const;
+
+		/* Ids whose boxes the segment from origin to origin + max_t * direction passes through, nearest first.
+		A ray starting inside a box hits it at t = 0. Replaces out.
+		*/
+		void RayCast(const Point2D& origin, const Point2D& direction, double max_t, std::vector<RayHit>& out) const;
+
+		// Levels below the root; 0 for a single leaf, -1 when empty.
+		int Height() const;
+
+		// Total perimeter of the inner nodes: what the heuristic keeps low, smaller is a better tree.
+		double Cost() const;
+
+		size_t Nodes() const { return nodes.size() - free_nodes.size(); }
+
+		// Leaves taken out and put back in by the moves since the last FindPairs.
+		uint64_t LastReinserts() const { return last_reinserts; }
+
+	private:
+		static constexpr int32_t Nil = -1;
+
+		struct Node {
+			Aabb box;			// Fat box for leaves, the union of the children's otherwise.
+			int32_t parent;
+			int32_t left;		// Nil for leaves.
+			int32_t right;
+			int32_t height;		// 0 for leaves.
+			Id id;				// Leaves only.
+		};
+
+		double margin;
+		std::vector<Node> nodes;
+		std::vector<int32_t> free_nodes;
+		int32_t root;
+
+		std::vector<Aabb> boxes;		// By id: the real boxes.
+		std::vector<int32_t> leaves;	// By id.
+		uint64_t reinserts;
+		uint64_t last_reinserts;
+
+		mutable std::vector<int32_t> stack;
+
+		std::vector<Pair> fat_pairs;	// Every pair of leaves whose fat boxes overlap, as of the last FindPairs.
+		std::vector<uint8_t> changed;	// By id: added, reinserted or removed since.
+		std::vector<Id> changed_ids;
+		std::vector<Id> hits;
+
+		void MarkChanged(Id id);
+
+		int32_t NewNode();
+		void FreeNode(int32_t node);
+		bool IsLeaf(int32_t node) const { return nodes[node].left == Nil; }
+
+		int32_t FindSibling(const Aabb& box) const;
+		void InsertLeaf(int32_t leaf);
+		void RemoveLeaf(int32_t leaf);
+		void Update(int32_t node);
+		void Refit(int32_t node);
+		int32_t Balance(int32_t node);
+		int32_t Promote(int32_t node, int32_t child);
+
+		uint64_t Collect(const Aabb& region, std::vector<Id>& out, bool fat) const;
+	};
+}
+
+#endif
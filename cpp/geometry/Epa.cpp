@@ -0,0 +1,194 @@
+#include "Epa.h"
+
+#include <cmath>
+
+#include "Predicates.h"
+
+namespace Geometry {
+
+	namespace {
+
+		const Point2D Origin = { 0, 0 };
+
+		Gjk::Vertex SupportVertex(const MinkowskiDifferenceShape& shape, const Point2D& direction) {
+			Gjk::Vertex vertex;
+			vertex.w = shape.Support(direction, vertex.a, vertex.b);
+			return vertex;
+		}
+
+		// Outward unit normal of the edge p -> q of a counterclockwise polygon.
+		Point2D OutwardNormal(const Point2D& p, const Point2D& q) {
+			Point2D edge = q - p;
+			double length = std::sqrt(Dot(edge, edge));
+			return Point2D{ edge.y / length, -edge.x / length };
+		}
+
+		bool Known(const Gjk::Vertex* polygon, size_t count, const Point2D& w) {
+			for (size_t i = 0; i < count; i++) {
+				if (polygon[i].w == w) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		void Remove(Gjk::Vertex* polygon, size_t& count, size_t index) {
+			for (size_t i = index; i + 1 < count; i++) {
+				polygon[i] = polygon[i + 1];
+			}
+			count--;
+		}
+
+		/* The difference is flat (a segment or a point: the shapes touch along a line at most), so zero depth,
+		with the normal across the segment (any direction for a point). The contact is where the origin sits on
+		the segment between its two ends.
+		*/
+		void Flat(const Gjk::Vertex* polygon, size_t count, Epa::Contact& contact) {
+			size_t low = 0;
+			size_t high = 0;
+			for (size_t i = 1; i < count; i++) {
+				if (polygon[i].w.x < polygon[low].w.x || (polygon[i].w.x == polygon[low].w.x && polygon[i].w.y < polygon[low].w.y)) {
+					low = i;
+				}
+				if (polygon[high].w.x < polygon[i].w.x || (polygon[high].w.x == polygon[i].w.x && polygon[high].w.y < polygon[i].w.y)) {
+					high = i;
+				}
+			}
+			const Gjk::Vertex& p = polygon[low];
+			const Gjk::Vertex& q = polygon[high];
+			double t = 0;
+			contact.depth = 0;
+			contact.normal = Point2D{ 1, 0 };
+			if (p.w != q.w) {
+				Point2D edge = q.w - p.w;
+				t = -Dot(p.w, edge) / Dot(edge, edge);
+				t = t < 0 ? 0 : (t > 1 ? 1 : t);
+				contact.normal = OutwardNormal(p.w, q.w);
+			}
+			contact.point_a = p.a + t * (q.a - p.a);
+			contact.point_b = p.b + t * (q.b - p.b);
+		}
+	}
+
+	bool Epa::Penetration(const MinkowskiDifferenceShape& shape, const Gjk::Simplex& simplex, Contact& contact) {
+		Gjk::Vertex polygon[MaxVertices];
+		size_t count = simplex.count;
+		for (size_t i = 0; i < count; i++) {
+			polygon[i] = simplex.vertices[i];
+		}
+		contact.iterations = 0;
+		contact.converged = true;
+
+		// GJK can stop at a point or a segment through the origin (the shapes touch); grow that to a triangle.
+		if (count == 1) {
+			if (polygon[0].w != Origin) {
+				return false;
+			}
+			polygon[count++] = SupportVertex(shape, Point2D{ 1, 0 });
+			if (polygon[1].w == polygon[0].w) {
+				polygon[1] = SupportVertex(shape, Point2D{ -1, 0 });
+			}
+		}
+		if (count == 2) {
+			Point2D edge = polygon[1].w - polygon[0].w;
+			Point2D across = { -edge.y, edge.x };
+			if (across == Origin) {
+				across = Point2D{ 0, 1 };
+			}
+			polygon[count++] = SupportVertex(shape, across);
+			if (Predicates::Orient2D(polygon[0].w, polygon[1].w, polygon[2].w) == 0) {
+				polygon[2] = SupportVertex(shape, -across);
+			}
+		}
+
+		int turn = Predicates::Orient2D(polygon[0].w, polygon[1].w, polygon[2].w);
+		if (turn == 0) {
+			Flat(polygon, count, contact);
+			return true;
+		}
+		if (turn < 0) {
+			Gjk::Vertex swap = polygon[1];
+			polygon[1] = polygon[2];
+			polygon[2] = swap;
+		}
+		for (size_t i = 0; i < 3; i++) {
+			if (Predicates::Orient2D(polygon[i].w, polygon[(i + 1) % 3].w, Origin) < 0) {
+				return false;
+			}
+		}
+
+		size_t closest = 0;
+		Point2D normal = Origin;
+		double distance = 0;
+		while (true) {
+			distance = INFINITY;
+			for (size_t i = 0; i < count; i++) {
+				Point2D edge_normal = OutwardNormal(polygon[i].w, polygon[(i + 1) % count].w);
+				double edge_distance = Dot(edge_normal, polygon[i].w);
+				if (edge_distance < distance) {
+					distance = edge_distance;
+					normal = edge_normal;
+					closest = i;
+				}
+			}
+
+			if (count == MaxVertices || contact.iterations == (int)MaxVertices) {
+				contact.converged = false;
+				break;
+			}
+			contact.iterations++;
+
+			// Done when the support gets no further out than the edge, relative to the size of the coordinates
+			// (near the origin, when the shapes barely touch, the distances themselves are only rounding).
+			Gjk::Vertex w = SupportVertex(shape, normal);
+			double support_distance = Dot(w.w, normal);
+			if (support_distance - distance <= Tolerance * (std::fabs(w.w.x) + std::fabs(w.w.y)) || Known(polygon, count, w.w)) {
+				break;
+			}
+
+			for (size_t i = count; i > closest + 1; i--) {
+				polygon[i] = polygon[i - 1];
+			}
+			polygon[closest + 1] = w;
+			count++;
+
+			/* w can land on the line of a neighbouring edge (shapes with parallel edges do that all the time), which
+			leaves the vertex between them in the middle of a straight side. Two collinear edges tie on distance and
+			the origin only projects into one of them, so the vertex goes.
+			*/
+			size_t at = closest + 1;
+			size_t after = (at + 1) % count;
+			if (Predicates::Orient2D(w.w, polygon[after].w, polygon[(after + 1) % count].w) == 0) {
+				Remove(polygon, count, after);
+				if (after < at) {
+					at--;
+				}
+			}
+			size_t before = (at + count - 1) % count;
+			if (count > 3 && Predicates::Orient2D(polygon[(before + count - 1) % count].w, polygon[before].w, w.w) == 0) {
+				Remove(polygon, count, before);
+			}
+		}
+
+		// Where the origin projects onto the closest edge, in both shapes.
+		const Gjk::Vertex& p = polygon[closest];
+		const Gjk::Vertex& q = polygon[(closest + 1) % count];
+		Point2D edge = q.w - p.w;
+		double t = -Dot(p.w, edge) / Dot(edge, edge);
+		t = t < 0 ? 0 : (t > 1 ? 1 : t);
+		contact.depth = distance < 0 ? 0 : distance;
+		contact.normal = normal;
+		contact.point_a = p.a + t * (q.a - p.a);
+		contact.point_b = p.b + t * (q.b - p.b);
+		return true;
+	}
+
+	bool Epa::Penetration(const SupportShape& first, const SupportShape& second, Contact& contact) {
+		MinkowskiDifferenceShape shape(first, second);
+		Gjk::Result result = Gjk::Query(shape);
+		if (!result.intersecting) {
+			return false;
+		}
+		return Penetration(shape, result.simplex, contact);
+	}
+}
@@ -0,0 +1,55 @@
+#ifndef _GEOMETRY_EPA_H
+#define _GEOMETRY_EPA_H
+#pragma once
+
+#include <cstddef>
+
+#include "Gjk.h"
+#include "Point2D.h"
+#include "SupportShape.h"
+
+namespace Geometry {
+
+	/* Expanding Polytope Algorithm: how deep two overlapping shapes are in each other, and which way out.
+
+	When GJK finds an overlap its last simplex holds the origin, inside first - second. EPA grows that into a
+	polygon inscribed in the difference: take the polygon's edge closest to the origin, ask the difference for
+	its support along that edge's outward normal and put the new point in between, until the support gets no
+	further out than the edge. Then the edge is (up to the tolerance) on the boundary of the difference, its
+	distance is the penetration depth and its normal the contact normal.
+
+	The polygon lives in a fixed array on the stack, so a query allocates nothing; at MaxVertices vertices (or
+	as many iterations) it stops with the best edge so far, and converged is false.
+	*/
+	class Epa {
+
+	public:
+		static const size_t MaxVertices = 64;
+
+		// Relative tolerance on the depth.
+		static constexpr double Tolerance = 1e-10;
+
+		/* Moving first by -depth * normal (or second by depth * normal) makes them just touch. point_a is the
+		point of first deepest inside second, point_b the one of second deepest inside first, and
+		point_a - point_b = depth * normal.
+		*/
+		struct Contact {
+			double depth;
+			Point2D normal;		// Unit length, pointing from first towards second.
+			Point2D point_a;
+			Point2D point_b;
+			int iterations;
+			bool converged;
+		};
+
+		/* From the simplex an intersecting Gjk::Query ended with. False if the shapes do not overlap after all
+		(the simplex does not hold the origin).
+		*/
+		static bool Penetration(const MinkowskiDifferenceShape& shape, const Gjk::Simplex& simplex, Contact& contact);
+
+		// GJK first; false (and contact untouched) if the shapes are apart.
+		static bool Penetration(const SupportShape& first, const SupportShape& second, Contact& contact);
+	};
+}
+
+#endif
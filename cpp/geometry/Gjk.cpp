@@ -0,0 +1,179 @@
+#include "Gjk.h"
+
+#include <cmath>
+
+#include "Predicates.h"
+
+namespace Geometry {
+
+	namespace {
+
+		const Point2D Origin = { 0, 0 };
+
+		/* Point of segment p-q closest to the origin, as the weight of q (0 is p, 1 is q). The regions are
+		told apart with the exact dot product signs, so an end point is kept exactly when it is the answer.
+		*/
+		double SegmentWeight(const Point2D& p, const Point2D& q) {
+			if (Predicates::DotSign(Origin, p, q, p) <= 0) {
+				return 0;
+			}
+			if (Predicates::DotSign(Origin, q, p, q) <= 0) {
+				return 1;
+			}
+			Point2D edge = q - p;
+			return -Dot(p, edge) / Dot(edge, edge);
+		}
+
+		/* Shrinks the simplex to the vertices that support its point closest to the origin, and returns that
+		point, with the barycentric weights of what is left in weights. A triangle only stays a triangle if it
+		holds the origin (then the point is the origin); a segment through the origin gives exactly the origin.
+		*/
+		Point2D Reduce(Gjk::Simplex& simplex, double weights[3]) {
+			Gjk::Vertex* v = simplex.vertices;
+			if (simplex.count == 1) {
+				weights[0] = 1;
+				return v[0].w;
+			}
+
+			if (simplex.count == 3) {
+				int turn = Predicates::Orient2D(v[0].w, v[1].w, v[2].w);
+				if (turn != 0) {
+					int s01 = Predicates::Orient2D(v[0].w, v[1].w, Origin) * turn;
+					int s12 = Predicates::Orient2D(v[1].w, v[2].w, Origin) * turn;
+					int s20 = Predicates::Orient2D(v[2].w, v[0].w, Origin) * turn;
+					if (s01 >= 0 && s12 >= 0 && s20 >= 0) {
+						weights[0] = weights[1] = weights[2] = 1.0 / 3;
+						return Origin;
+					}
+				}
+
+				// Outside (or a flat triangle): the closest point is on one of the edges.
+				size_t best = 0;
+				double best_distance = INFINITY;
+				for (size_t e = 0; e < 3; e++) {
+					const Point2D& p = v[e].w;
+					const Point2D& q = v[(e + 1) % 3].w;
+					double t = SegmentWeight(p, q);
+					Point2D closest = p + t * (q - p);
+					double distance = Dot(closest, closest);
+					if (distance < best_distance) {
+						best_distance = distance;
+						best = e;
+					}
+				}
+				Gjk::Vertex p = v[best];
+				Gjk::Vertex q = v[(best + 1) % 3];
+				v[0] = p;
+				v[1] = q;
+				simplex.count = 2;
+			}
+
+			double t = SegmentWeight(v[0].w, v[1].w);
+			if (t == 0 || t == 1) {
+				if (t == 1) {
+					v[0] = v[1];
+				}
+				simplex.count = 1;
+				weights[0] = 1;
+				return v[0].w;
+			}
+			weights[0] = 1 - t;
+			weights[1] = t;
+			if (Predicates::Orient2D(v[0].w, v[1].w, Origin) == 0) {
+				return Origin;
+			}
+			return v[0].w + t * (v[1].w - v[0].w);
+		}
+
+		bool Duplicate(const Gjk::Simplex& simplex, const Point2D& w) {
+			for (size_t i = 0; i < simplex.count; i++) {
+				if (simplex.vertices[i].w == w) {
+					return true;
+				}
+			}
+			return false;
+		}
+
+		Gjk::Vertex SupportVertex(const MinkowskiDifferenceShape& shape, const Point2D& direction) {
+			Gjk::Vertex vertex;
+			vertex.w = shape.Support(direction, vertex.a, vertex.b);
+			return vertex;
+		}
+	}
+
+	/* v is the closest point of the simplex to the origin, w the support of the difference towards the origin
+	(it minimizes the dot product with v over the whole difference). Dot(v, w) > 0 then says the line through
+	w across v has all of the difference on one side and the origin on the other: separated. v is rounded,
+	though, and for shapes that touch the exact answer is 0, so the early out wants a margin over the rounding
+	of the dot product; anything closer is settled by the exact tests below. And since the true distance lies
+	between Dot(v, w) / |v| and |v|, once those meet v is the closest point.
+	*/
+	Gjk::Result Gjk::Query(const MinkowskiDifferenceShape& shape, const Point2D& direction, bool stop_at_separation) {
+		Result result;
+		result.intersecting = false;
+		result.iterations = 0;
+
+		Simplex& simplex = result.simplex;
+		double weights[3] = { 1, 0, 0 };
+		Point2D start = direction == Origin ? Point2D{ 1, 0 } : direction;
+		simplex.vertices[0] = SupportVertex(shape, -start);
+		simplex.count = 1;
+		Point2D v = simplex.vertices[0].w;
+		Point2D searched = start;
+
+		while (result.iterations < MaxIterations) {
+			result.iterations++;
+			if (v == Origin) {
+				result.intersecting = true;
+				break;
+			}
+
+			searched = v;
+			Vertex w = SupportVertex(shape, -v);
+			double vv = Dot(v, v);
+			double vw = Dot(v, w.w);
+			if (stop_at_separation && vw > Tolerance * std::sqrt(vv * Dot(w.w, w.w))) {
+				break;
+			}
+			if (vv - vw <= Tolerance * vv || Duplicate(simplex, w.w)) {
+				break;
+			}
+
+			simplex.vertices[simplex.count++] = w;
+			v = Reduce(simplex, weights);
+			if (simplex.count == 3) {
+				result.intersecting = true;
+				break;
+			}
+		}
+
+		result.axis = result.intersecting ? searched : v;
+		result.distance = result.intersecting ? 0 : std::sqrt(Dot(v, v));
+		result.point_a = Origin;
+		result.point_b = Origin;
+		if (!result.intersecting) {
+			for (size_t i = 0; i < simplex.count; i++) {
+				result.point_a = result.point_a + weights[i] * simplex.vertices[i].a;
+				result.point_b = result.point_b + weights[i] * simplex.vertices[i].b;
+			}
+		}
+		return result;
+	}
+
+	// Start out from the centers: the first support is taken towards the origin from the difference's center.
+	Gjk::Result Gjk::Query(const MinkowskiDifferenceShape& shape) {
+		return Query(shape, shape.Center(), false);
+	}
+
+	Gjk::Result Gjk::Query(const SupportShape& first, const SupportShape& second) {
+		return Query(MinkowskiDifferenceShape(first, second));
+	}
+
+	bool Gjk::Intersecting(const MinkowskiDifferenceShape& shape) {
+		return Query(shape, shape.Center(), true).intersecting;
+	}
+
+	bool Gjk::Intersecting(const SupportShape& first, const SupportShape& second) {
+		return Intersecting(MinkowskiDifferenceShape(first, second));
+	}
+}
@@ -0,0 +1,70 @@
+#ifndef _GEOMETRY_GJK_H
+#define _GEOMETRY_GJK_H
+#pragma once
+
+#include <cstddef>
+
+#include "Point2D.h"
+#include "SupportShape.h"
+
+namespace Geometry {
+
+	/* Gilbert-Johnson-Keerthi: do two convex shapes overlap, and if not, how far apart are they.
+
+	Both questions are about the origin and first - second. GJK keeps a simplex (up to a triangle) of points of
+	the difference and the point v of it closest to the origin, asks the difference for its support towards
+	the origin (-v) and keeps the smallest simplex that still holds the new closest point. That converges on
+	the closest point of the whole difference; or the triangle comes to contain the origin, and the shapes
+	overlap. It only ever calls Support, so every iteration is O(n + m) for two hulls and nothing is allocated.
+
+	Whether the origin is inside the triangle (or on a segment) is decided with the exact predicates, so
+	touching counts as overlapping, same as the edge test, and one hull inside the other is found as well.
+	*/
+	class Gjk {
+
+	public:
+		static const int MaxIterations = 64;
+
+		// Relative tolerance on the distance: done when a new support point gets no closer than this.
+		static constexpr double Tolerance = 1e-12;
+
+		// A corner of the simplex: w = a - b, with a on the first shape and b on the second.
+		struct Vertex {
+			Point2D w;
+			Point2D a;
+			Point2D b;
+		};
+
+		struct Simplex {
+			Vertex vertices[3];
+			size_t count;
+		};
+
+		struct Result {
+			bool intersecting;
+			double distance;	// 0 when intersecting.
+			Point2D point_a;	// Closest points of the two shapes; only meaningful when not intersecting.
+			Point2D point_b;
+			Point2D axis;		// point_a - point_b when apart, a separating direction (points from second to first);
+								// when intersecting, the last direction searched. Either is a good start for next time.
+			int iterations;
+			Simplex simplex;	// The last one. When intersecting it holds the origin; Epa starts from it.
+		};
+
+		// Distance query: runs until the closest points are found (or the shapes overlap).
+		static Result Query(const MinkowskiDifferenceShape& shape);
+		static Result Query(const SupportShape& first, const SupportShape& second);
+
+		// Boolean only: stops at the first separating axis, which usually comes long before the closest points.
+		static bool Intersecting(const MinkowskiDifferenceShape& shape);
+		static bool Intersecting(const SupportShape& first, const SupportShape& second);
+
+		/* Both of the above, starting out along direction (from second towards first) rather than from the two
+		centers. With stop_at_separation it returns as soon as some axis separates them, without distance and
+		closest points.
+		*/
+		static Result Query(const MinkowskiDifferenceShape& shape, const Point2D& direction, bool stop_at_separation);
+	};
+}
+
+#endif
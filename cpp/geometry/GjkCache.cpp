@@ -0,0 +1,65 @@
+#include "GjkCache.h"
+
+#include <cmath>
+
+namespace Geometry {
+
+	GjkCache::GjkCache() {
+		ResetStats();
+	}
+
+	Gjk::Result GjkCache::Run(Key key, const MinkowskiDifferenceShape& shape, bool stop_at_separation) {
+		auto cached = axes.find(key);
+		Point2D direction = shape.Center();
+		if (cached != axes.end()) {
+			direction = cached->second;
+			totals.warm_starts++;
+		}
+		Gjk::Result result = Gjk::Query(shape, direction, stop_at_separation);
+		totals.iterations += result.iterations;
+		if (result.axis != Point2D{ 0, 0 }) {
+			axes[key] = result.axis;
+		}
+		return result;
+	}
+
+	/* The early out is GJK's own separation test with the old axis for v: if the support of the difference
+	against it is still on the far side of the origin (by more than the rounding), the old axis separates.
+	*/
+	bool GjkCache::Intersecting(Key key, const MinkowskiDifferenceShape& shape) {
+		totals.queries++;
+		auto cached = axes.find(key);
+		if (cached != axes.end()) {
+			const Point2D& axis = cached->second;
+			Point2D w = shape.Support(-axis);
+			double vw = Dot(axis, w);
+			if (vw > Gjk::Tolerance * std::sqrt(Dot(axis, axis) * Dot(w, w))) {
+				totals.iterations++;
+				totals.early_outs++;
+				return false;
+			}
+		}
+		return Run(key, shape, true).intersecting;
+	}
+
+	Gjk::Result GjkCache::Query(Key key, const MinkowskiDifferenceShape& shape) {
+		totals.queries++;
+		return Run(key, shape, false);
+	}
+
+	void GjkCache::Forget(Key key) {
+		axes.erase(key);
+	}
+
+	void GjkCache::Clear() {
+		axes.clear();
+	}
+
+	void GjkCache::ResetStats() {
+		totals = Stats{ 0, 0, 0, 0 };
+	}
+
+	double GjkCache::AverageIterations() const {
+		return totals.queries == 0 ? 0.0 : (double)totals.iterations / totals.queries;
+	}
+}
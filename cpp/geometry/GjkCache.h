@@ -0,0 +1,65 @@
+#ifndef _GEOMETRY_GJKCACHE_H
+#define _GEOMETRY_GJKCACHE_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+
+#include "Gjk.h"
+#include "Point2D.h"
+#include "SupportShape.h"
+
+namespace Geometry {
+
+	/* Last frame's GJK answer for every pair that keeps being asked about, to start this frame's from.
+
+	Shapes in a game (or hulls being dragged around) barely move between two frames, so the axis that separated
+	a pair last time almost always still does. Intersecting first tries exactly that: one support query on the
+	difference, and if the old axis still separates, that is the answer (an early out). Otherwise, and for
+	distance queries, GJK starts along the old axis instead of from the centers, which puts its first support
+	point next to where it ended last time.
+
+	Pairs are told apart by a key the caller picks (PairKey packs two ids). Stats count queries, GJK iterations
+	(an early out counts as one) and early outs, so AverageIterations can be compared with plain Gjk.
+
+	Not thread safe; one per thread or simulation.
+	*/
+	class GjkCache {
+
+	public:
+		typedef uint64_t Key;
+
+		struct Stats {
+			uint64_t queries;
+			uint64_t iterations;
+			uint64_t early_outs;	// The cached axis still separated the pair.
+			uint64_t warm_starts;	// GJK ran, starting from a cached axis.
+		};
+
+		GjkCache();
+
+		static Key PairKey(uint32_t first, uint32_t second) { return ((Key)first << 32) | second; }
+
+		bool Intersecting(Key key, const MinkowskiDifferenceShape& shape);
+		Gjk::Result Query(Key key, const MinkowskiDifferenceShape& shape);
+
+		// Drop a pair (one of its shapes is gone), or all of them.
+		void Forget(Key key);
+		void Clear();
+		size_t Pairs() const { return axes.size(); }
+
+		const Stats& Totals() const { return totals; }
+		void ResetStats();
+		double AverageIterations() const;
+
+	private:
+		std::unordered_map<Key, Point2D> axes;
+		Stats totals;
+
+		// Seeds from the cached axis (or the centers, first time round) and remembers where this one ended.
+		Gjk::Result Run(Key key, const MinkowskiDifferenceShape& shape, bool stop_at_separation);
+	};
+}
+
+#endif
@@ -0,0 +1,71 @@
+#include "HullCache.h"
+
+namespace Geometry {
+
+	HullCache::HullCache() : totals{ 0, 0, 0, 0 }, misses_at_frame(0) {
+	}
+
+	// Versions start at 1 and entries at 0; the first Refresh of an entry is a miss either way (never_built).
+	HullCache::Input HullCache::AddInput() {
+		versions.push_back(1);
+		return versions.size() - 1;
+	}
+
+	void HullCache::Touch(Input input) {
+		versions[input]++;
+	}
+
+	HullCache::Entry HullCache::AddEntry(std::initializer_list<Input> inputs) {
+		Slot slot;
+		slot.inputs.assign(inputs.begin(), inputs.end());
+		slot.built.assign(inputs.size(), 0);
+		slot.never_built = true;
+		entries.push_back(slot);
+		return entries.size() - 1;
+	}
+
+	bool HullCache::Refresh(Entry entry) {
+		Slot& slot = entries[entry];
+		bool stale = slot.never_built;
+		slot.never_built = false;
+		for (size_t i = 0; i < slot.inputs.size(); i++) {
+			uint64_t version = versions[slot.inputs[i]];
+			if (slot.built[i] != version) {
+				slot.built[i] = version;
+				stale = true;
+			}
+		}
+		if (stale) {
+			totals.misses++;
+		}
+		else {
+			totals.hits++;
+		}
+		return stale;
+	}
+
+	const std::vector<Point2D>& HullCache::Get(Entry entry, const Build& build) {
+		if (Refresh(entry)) {
+			build(entries[entry].hull);
+		}
+		return entries[entry].hull;
+	}
+
+	void HullCache::EndFrame() {
+		totals.frames++;
+		if (totals.misses == misses_at_frame) {
+			totals.idle_frames++;
+		}
+		misses_at_frame = totals.misses;
+	}
+
+	void HullCache::ResetStats() {
+		totals = Stats{ 0, 0, 0, 0 };
+		misses_at_frame = 0;
+	}
+
+	double HullCache::HitRate() const {
+		uint64_t lookups = totals.hits + totals.misses;
+		return lookups == 0 ? 1.0 : (double)totals.hits / lookups;
+	}
+}
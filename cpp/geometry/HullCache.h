@@ -0,0 +1,83 @@
+#ifndef _GEOMETRY_HULLCACHE_H
+#define _GEOMETRY_HULLCACHE_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <initializer_list>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace Geometry {
+
+	/* Derived hulls that are only rebuilt when something they depend on changed.
+
+	Every input (a point set, the size of the view, ...) gets a version number, and whoever changes the input
+	bumps it with Touch. An entry depends on a few inputs and remembers their versions from when it was last
+	built; asking for it again while they all still match is a hit and costs a few compares. Anything else is
+	a miss and rebuilds it.
+
+	Entries usually hold a hull (Get), but Refresh works without one, for results that live elsewhere (a bool,
+	say). EndFrame counts frames and how many of them had no miss at all: with nothing edited that should be
+	every one of them.
+
+	Not thread safe; it belongs to whoever owns the inputs.
+	*/
+	class HullCache {
+
+	public:
+		typedef size_t Input;
+		typedef size_t Entry;
+		typedef std::function<void(std::vector<Point2D>& hull)> Build;
+
+		struct Stats {
+			uint64_t hits;
+			uint64_t misses;
+			uint64_t frames;
+			uint64_t idle_frames;	// Frames without a single miss.
+		};
+
+		HullCache();
+
+		Input AddInput();
+		void Touch(Input input);
+		uint64_t Version(Input input) const { return versions[input]; }
+
+		Entry AddEntry(std::initializer_list<Input> inputs);
+
+		/* True (a miss) if an input of entry changed since the last Refresh, or there was none yet; the entry
+		then counts as up to date with the current versions. False is a hit.
+		*/
+		bool Refresh(Entry entry);
+
+		/* The hull of entry, rebuilt by build (which gets the old hull to overwrite) only on a miss. The reference
+		stays valid until the next AddEntry.
+		*/
+		const std::vector<Point2D>& Get(Entry entry, const Build& build);
+
+		void EndFrame();
+
+		const Stats& Totals() const { return totals; }
+		void ResetStats();
+
+		// Share of lookups that were hits, 1 if there were none.
+		double HitRate() const;
+
+	private:
+		struct Slot {
+			std::vector<Input> inputs;
+			std::vector<uint64_t> built;
+			bool never_built;	// Until the first Refresh; an entry without inputs has nothing else to miss on.
+			std::vector<Point2D> hull;
+		};
+
+		std::vector<uint64_t> versions;
+		std::vector<Slot> entries;
+		Stats totals;
+		uint64_t misses_at_frame;
+	};
+}
+
+#endif
@@ -0,0 +1,141 @@
+#include "HullClassifier.h"
+
+#include <algorithm>
+
+#include "HullKernels.h"
+#include "HullMath.h"
+
+namespace Geometry {
+
+	namespace {
+
+		// Tasks a thread gets, so a slow chunk does not leave the others waiting.
+		const size_t TasksPerThread = 4;
+
+		/* chunk(begin, end) over [0, n) in ChunkPoints pieces, spread over the pool in a few tasks of whole
+		chunks each, unless n is too small to bother.
+		*/
+		template <typename F>
+		void ForChunks(size_t n, TaskPool* pool, F chunk) {
+			const size_t size = HullClassifier::ChunkPoints;
+			if (!pool || n < HullClassifier::ParallelPoints || pool->ThreadCount() == 1) {
+				for (size_t begin = 0; begin < n; begin += size) {
+					chunk(begin, std::min(n, begin + size));
+				}
+				return;
+			}
+
+			size_t chunks = (n + size - 1) / size;
+			size_t tasks = std::min(chunks, (size_t)pool->ThreadCount() * TasksPerThread);
+			TaskGroup group(*pool);
+			for (size_t t = 0; t < tasks; t++) {
+				size_t first = chunks * t / tasks;
+				size_t last = chunks * (t + 1) / tasks;
+				group.Run([=]() {
+					for (size_t c = first; c < last; c++) {
+						chunk(c * size, std::min(n, (c + 1) * size));
+					}
+				});
+			}
+			group.Wait();
+		}
+	}
+
+	HullClassifier::HullClassifier() {}
+
+	HullClassifier::HullClassifier(const std::vector<std::vector<Point2D>>& hulls) {
+		for (const std::vector<Point2D>& hull : hulls) {
+			Add(hull);
+		}
+	}
+
+	int32_t HullClassifier::Add(const Point2D* hull, size_t n) {
+		if (hulls.size() == MaxHulls) {
+			return NoHull;
+		}
+		Hull entry = { vertices.size(), n, n > 0 ? BoundsOf(hull, n) : Aabb{ Point2D{ 0, 0 }, Point2D{ 0, 0 } } };
+		for (size_t i = 0; i < n; i++) {
+			vertices.push_back(hull[i]);
+			edges.push_back(hull[i + 1 < n ? i + 1 : 0] - hull[i]);
+		}
+		hulls.push_back(entry);
+		return (int32_t)hulls.size() - 1;
+	}
+
+	int32_t HullClassifier::Add(const std::vector<Point2D>& hull) {
+		return Add(hull.data(), hull.size());
+	}
+
+	void HullClassifier::Clear() {
+		vertices.clear();
+		edges.clear();
+		hulls.clear();
+	}
+
+	/* Hulls whose bounds miss the chunk's are skipped: with points stored roughly by where they are (particles
+	from one emitter, samples of one region) most chunks only meet a hull or two. Points and segments are rare
+	enough to take one at a time.
+	*/
+	void HullClassifier::ClassifyChunk(const double* x, const double* y, size_t n, uint32_t* masks) const {
+		std::fill(masks, masks + n, 0u);
+		if (n == 0) {
+			return;
+		}
+		Aabb chunk = { Point2D{ x[0], y[0] }, Point2D{ x[0], y[0] } };
+		for (size_t i = 1; i < n; i++) {
+			chunk.min.x = std::min(chunk.min.x, x[i]);
+			chunk.min.y = std::min(chunk.min.y, y[i]);
+			chunk.max.x = std::max(chunk.max.x, x[i]);
+			chunk.max.y = std::max(chunk.max.y, y[i]);
+		}
+
+		for (size_t h = 0; h < hulls.size(); h++) {
+			const Hull& hull = hulls[h];
+			uint32_t bit = 1u << h;
+			if (hull.count == 0 || !Overlaps(hull.bounds, chunk)) {
+				continue;
+			}
+			if (hull.count >= 3) {
+				HullKernels::MarkInside(x, y, n, vertices.data() + hull.start, edges.data() + hull.start, hull.count, bit, masks);
+			}
+			else {
+				for (size_t i = 0; i < n; i++) {
+					if (HullMath::ContainsPoint(vertices.data() + hull.start, hull.count, Point2D{ x[i], y[i] })) {
+						masks[i] |= bit;
+					}
+				}
+			}
+		}
+	}
+
+	void HullClassifier::LocateChunk(const double* x, const double* y, size_t n, int32_t* ids) const {
+		uint32_t masks[ChunkPoints];
+		ClassifyChunk(x, y, n, masks);
+		for (size_t i = 0; i < n; i++) {
+			int32_t id = NoHull;
+			for (uint32_t mask = masks[i], h = 0; mask; mask >>= 1, h++) {
+				if (mask & 1) {
+					id = (int32_t)h;
+					break;
+				}
+			}
+			ids[i] = id;
+		}
+	}
+
+	void HullClassifier::Classify(const double* x, const double* y, size_t n, uint32_t* masks) const {
+		ForChunks(n, nullptr, [&](size_t begin, size_t end) { ClassifyChunk(x + begin, y + begin, end - begin, masks + begin); });
+	}
+
+	void HullClassifier::Classify(const double* x, const double* y, size_t n, uint32_t* masks, TaskPool& pool) const {
+		ForChunks(n, &pool, [&](size_t begin, size_t end) { ClassifyChunk(x + begin, y + begin, end - begin, masks + begin); });
+	}
+
+	void HullClassifier::Locate(const double* x, const double* y, size_t n, int32_t* ids) const {
+		ForChunks(n, nullptr, [&](size_t begin, size_t end) { LocateChunk(x + begin, y + begin, end - begin, ids + begin); });
+	}
+
+	void HullClassifier::Locate(const double* x, const double* y, size_t n, int32_t* ids, TaskPool& pool) const {
+		ForChunks(n, &pool, [&](size_t begin, size_t end) { LocateChunk(x + begin, y + begin, end - begin, ids + begin); });
+	}
+}
@@ -0,0 +1,79 @@
+#ifndef _GEOMETRY_HULLCLASSIFIER_H
+#define _GEOMETRY_HULLCLASSIFIER_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Aabb.h"
+#include "Point2D.h"
+#include "TaskPool.h"
+
+namespace Geometry {
+
+	/* Which of a handful of hulls each of a great many points is in: projectiles, particles, sample points,
+	every frame. ContainsPoint one point at a time spends most of its time getting to the next point.
+
+	The points come as two arrays (x and y, structure of arrays), the way they can be loaded four to a register.
+	Each hull's edges are worked out once when it is added; a batch then goes through HullKernels::MarkInside
+	hull by hull, chunk by chunk, every point against every edge's half-plane in SIMD lanes, a lane dropping out
+	once the points are all out. The answer per point is a bitmask of the hulls it is in, or the first of them.
+	Exact, and the boundary counts as inside, like ContainsPoint.
+
+	A point within a hull's bounds costs every one of its edges, where the wedge search takes log n steps, so
+	this is for hulls of a few dozen vertices at most; for big ones, ConvexHullLocator.
+
+	Big batches are split into chunks for a TaskPool; each chunk writes only its own part of the output.
+	*/
+	class HullClassifier {
+
+	public:
+		// A mask has a bit per hull.
+		static const size_t MaxHulls = 32;
+
+		static const int32_t NoHull = -1;
+
+		// Points a chunk gets; x, y and the masks of one stay in L1 while every hull goes over them.
+		static const size_t ChunkPoints = 1024;
+
+		// Below this many points, a batch is not worth the threads.
+		static const size_t ParallelPoints = 65536;
+
+		HullClassifier();
+		explicit HullClassifier(const std::vector<std::vector<Point2D>>& hulls);
+
+		/* Same contract as HullMath::ContainsPoint (one or two points make a point or a segment). Returns the
+		hull's bit number, or NoHull if there are MaxHulls already.
+		*/
+		int32_t Add(const Point2D* hull, size_t n);
+		int32_t Add(const std::vector<Point2D>& hull);
+
+		void Clear();
+		size_t Size() const { return hulls.size(); }
+
+		// masks[i]: bit h set if point i is in hull h.
+		void Classify(const double* x, const double* y, size_t n, uint32_t* masks) const;
+		void Classify(const double* x, const double* y, size_t n, uint32_t* masks, TaskPool& pool) const;
+
+		// ids[i]: the lowest-numbered hull point i is in, or NoHull.
+		void Locate(const double* x, const double* y, size_t n, int32_t* ids) const;
+		void Locate(const double* x, const double* y, size_t n, int32_t* ids, TaskPool& pool) const;
+
+	private:
+		struct Hull {
+			size_t start;		// Into vertices and edges.
+			size_t count;
+			Aabb bounds;
+		};
+
+		std::vector<Point2D> vertices;	// All hulls back to back.
+		std::vector<Point2D> edges;		// edges[k]: the next vertex of the same hull minus vertices[k].
+		std::vector<Hull> hulls;
+
+		void ClassifyChunk(const double* x, const double* y, size_t n, uint32_t* masks) const;
+		void LocateChunk(const double* x, const double* y, size_t n, int32_t* ids) const;
+	};
+}
+
+#endif
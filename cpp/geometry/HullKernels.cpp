@@ -0,0 +1,830 @@
+#include "HullKernels.h"
+
+#include <atomic>
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+
+#include "Aabb.h"
+#include "MonotoneChain.h"
+#include "Predicates.h"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define GEOMETRY_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang only emit AVX2 inside functions that ask for it; MSVC accepts the intrinsics anywhere.
+#if defined(GEOMETRY_X86) && (defined(__GNUC__) || defined(__clang__))
+#define GEOMETRY_TARGET(isa) __attribute__((target(isa)))
+#else
+#define GEOMETRY_TARGET(isa)
+#endif
+
+namespace Geometry {
+
+	namespace {
+
+		typedef HullKernels::EdgeScan(*ScanEdgeFn)(const double*, const double*, size_t, const Point2D&, const Point2D&);
+		typedef size_t(*CullInsideFn)(double*, double*, size_t, const Point2D*, size_t);
+		typedef void(*SmallHullsFn)(double*, double*, size_t, double*, double*, size_t*);
+		typedef void(*MarkInsideFn)(const double*, const double*, size_t, const Point2D*, const Point2D*, size_t, uint32_t, uint32_t*);
+
+		const size_t MaxCorners = 8;
+
+		/* Edge i of the polygon as origin + direction, so that the inside test per edge is the same arithmetic
+		as Cross(polygon[i], polygon[i + 1], p) > 0. Where that is too close to zero to trust, the edge is
+		tested again with Predicates::Orient2D; the vector loops do the same for their uncertain lanes.
+		*/
+		struct PolygonEdges {
+			double ox[MaxCorners], oy[MaxCorners], ex[MaxCorners], ey[MaxCorners];
+			Point2D from[MaxCorners], to[MaxCorners];
+			size_t count;
+
+			PolygonEdges(const Point2D* polygon, size_t corners) : count(corners) {
+				for (size_t i = 0; i < corners; i++) {
+					const Point2D& a = polygon[i];
+					const Point2D& b = polygon[(i + 1) % corners];
+					ox[i] = a.x;
+					oy[i] = a.y;
+					ex[i] = b.x - a.x;
+					ey[i] = b.y - a.y;
+					from[i] = a;
+					to[i] = b;
+				}
+			}
+
+			bool Inside(double x, double y) const {
+				for (size_t i = 0; i < count; i++) {
+					double left = ex[i] * (y - oy[i]);
+					double right = ey[i] * (x - ox[i]);
+					double cross = left - right;
+					if (std::fabs(cross) < Predicates::OrientErrorBound * (std::fabs(left) + std::fabs(right))) {
+						if (Predicates::Orient2D(from[i], to[i], Point2D{ x, y }) <= 0) {
+							return false;
+						}
+					}
+					else if (!(cross > 0)) {
+						return false;
+					}
+				}
+				return true;
+			}
+		};
+
+		// Running best of the scan. Strictly better only, so the earliest point wins a full tie.
+		struct Best {
+			double dist;
+			double along;
+			size_t index;
+		};
+
+		inline void Consider(Best& best, double dist, double along, size_t index) {
+			if (dist > 0 && (dist > best.dist || (dist == best.dist && along < best.along))) {
+				best.dist = dist;
+				best.along = along;
+				best.index = index;
+			}
+		}
+
+		/* A distance too close to zero for its sign to be sure (|dist| below the orientation error bound)
+		is settled exactly: a point that is really outside keeps its distance, but at least the smallest
+		positive double, and any other point gets 0. Every kernel does this for exactly the same lanes, so
+		they still agree bit for bit.
+		*/
+		inline double Settle(double dist, double px, double py, const Point2D& p1, const Point2D& p2) {
+			if (Predicates::Orient2D(p1, p2, Point2D{ px, py }) < 0) {
+				return dist > DBL_MIN ? dist : DBL_MIN;
+			}
+			return 0;
+		}
+
+		// The same arithmetic as Cross(p1, p2, p), negated so that "right of the edge" is positive.
+		void ScanTail(const double* x, const double* y, size_t begin, size_t n, const Point2D& p1, const Point2D& p2, double ex, double ey, Best& best, size_t& outside) {
+			for (size_t i = begin; i < n; i++) {
+				double dx = x[i] - p1.x;
+				double dy = y[i] - p1.y;
+				double left = ex * dy;
+				double right = ey * dx;
+				double dist = -(left - right);
+				if (std::fabs(dist) < Predicates::OrientErrorBound * (std::fabs(left) + std::fabs(right))) {
+					dist = Settle(dist, x[i], y[i], p1, p2);
+				}
+				double along = dx * ex + dy * ey;
+				outside += dist > 0 ? 1 : 0;
+				Consider(best, dist, along, i);
+			}
+		}
+
+		HullKernels::EdgeScan ScanEdgeScalar(const double* x, const double* y, size_t n, const Point2D& p1, const Point2D& p2) {
+			Best best = { 0, 0, 0 };
+			size_t outside = 0;
+			ScanTail(x, y, 0, n, p1, p2, p2.x - p1.x, p2.y - p1.y, best, outside);
+			return HullKernels::EdgeScan{ best.index, outside };
+		}
+
+		// The polygon needs at least three corners to have an inside at all.
+		size_t CullInsideScalar(double* x, double* y, size_t n, const Point2D* polygon, size_t corners) {
+			if (corners < 3) {
+				return n;
+			}
+			PolygonEdges edges(polygon, corners);
+			size_t kept = 0;
+			for (size_t i = 0; i < n; i++) {
+				double px = x[i];
+				double py = y[i];
+				x[kept] = px;
+				y[kept] = py;
+				kept += edges.Inside(px, py) ? 0 : 1;
+			}
+			return kept;
+		}
+
+		/* PolygonEdges::Inside for any number of corners with the edges given, and the boundary counting as
+		inside: a point is out as soon as one edge has it surely to the right.
+		*/
+		bool InsideOrOn(const Point2D* polygon, const Point2D* edges, size_t corners, double x, double y) {
+			for (size_t e = 0; e < corners; e++) {
+				double left = edges[e].x * (y - polygon[e].y);
+				double right = edges[e].y * (x - polygon[e].x);
+				double cross = left - right;
+				if (std::fabs(cross) < Predicates::OrientErrorBound * (std::fabs(left) + std::fabs(right))) {
+					if (Predicates::Orient2D(polygon[e], polygon[e + 1 < corners ? e + 1 : 0], Point2D{ x, y }) < 0) {
+						return false;
+					}
+				}
+				else if (cross < 0) {
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// The vector versions test the polygon's bounds first as well, the cheapest way out for far away points.
+		void MarkInsideScalar(const double* x, const double* y, size_t n, const Point2D* polygon, const Point2D* edges, size_t corners,
+			uint32_t bit, uint32_t* masks) {
+			Aabb box = BoundsOf(polygon, corners);
+			for (size_t i = 0; i < n; i++) {
+				if (x[i] < box.min.x || x[i] > box.max.x || y[i] < box.min.y || y[i] > box.max.y) {
+					continue;
+				}
+				if (InsideOrOn(polygon, edges, corners, x[i], y[i])) {
+					masks[i] |= bit;
+				}
+			}
+		}
+
+		// The lanes in inside that the filter could not vouch for get the exact test; the rest of inside stands.
+		inline void MarkLanes(const Point2D* polygon, const Point2D* edges, size_t corners, const double* x, const double* y,
+			unsigned inside, unsigned uncertain, int lanes, uint32_t bit, uint32_t* masks) {
+			for (int lane = 0; lane < lanes; lane++) {
+				if (((inside >> lane) & 1) && (!((uncertain >> lane) & 1) || InsideOrOn(polygon, edges, corners, x[lane], y[lane]))) {
+					masks[lane] |= bit;
+				}
+			}
+		}
+
+		const size_t Sets = HullKernels::SmallHullLanes;
+
+		/* MonotoneChain on one lane after the other, with or without its sort. A sorting network is all branches
+		without the lanes to run it in, and std::sort beats it at these sizes.
+		*/
+		void HullLanes(const double* x, const double* y, size_t n, double* hull_x, double* hull_y, size_t* sizes, bool sorted) {
+			Point2D points[HullKernels::MaxSmallHull];
+			Point2D hull[HullKernels::MaxSmallHull + 1];
+			for (size_t s = 0; s < Sets; s++) {
+				for (size_t k = 0; k < n; k++) {
+					points[k] = Point2D{ x[Sets * k + s], y[Sets * k + s] };
+				}
+				sizes[s] = sorted ? MonotoneChain::ChainSorted(points, n, hull) : MonotoneChain::GetConvexHull(points, n, hull);
+				for (size_t k = 0; k < sizes[s]; k++) {
+					hull_x[Sets * k + s] = hull[k].x;
+					hull_y[Sets * k + s] = hull[k].y;
+				}
+			}
+		}
+
+		void SmallHullsScalar(double* x, double* y, size_t n, double* hull_x, double* hull_y, size_t* sizes) {
+			HullLanes(x, y, n, hull_x, hull_y, sizes, false);
+		}
+
+#if defined(GEOMETRY_X86)
+
+		inline int PopCount(unsigned mask) {
+			int count = 0;
+			for (; mask; mask &= mask - 1) {
+				count++;
+			}
+			return count;
+		}
+
+		GEOMETRY_TARGET("sse2")
+		HullKernels::EdgeScan ScanEdgeSse2(const double* x, const double* y, size_t n, const Point2D& p1, const Point2D& p2) {
+			const double ex = p2.x - p1.x;
+			const double ey = p2.y - p1.y;
+			const __m128d vx0 = _mm_set1_pd(p1.x);
+			const __m128d vy0 = _mm_set1_pd(p1.y);
+			const __m128d vex = _mm_set1_pd(ex);
+			const __m128d vey = _mm_set1_pd(ey);
+			const __m128d zero = _mm_setzero_pd();
+			const __m128d sign = _mm_set1_pd(-0.0);
+			const __m128d vbound = _mm_set1_pd(Predicates::OrientErrorBound);
+
+			__m128d best_dist = zero;
+			__m128d best_along = zero;
+			__m128d best_index = _mm_setzero_pd();
+			__m128d lane_index = _mm_set_pd(1.0, 0.0);
+			const __m128d step = _mm_set1_pd(2.0);
+			size_t outside = 0;
+
+			size_t i = 0;
+			for (; i + 2 <= n; i += 2) {
+				__m128d dx = _mm_sub_pd(_mm_loadu_pd(x + i), vx0);
+				__m128d dy = _mm_sub_pd(_mm_loadu_pd(y + i), vy0);
+				__m128d left = _mm_mul_pd(vex, dy);
+				__m128d right = _mm_mul_pd(vey, dx);
+				__m128d dist = _mm_sub_pd(zero, _mm_sub_pd(left, right));
+				__m128d bound = _mm_mul_pd(vbound, _mm_add_pd(_mm_andnot_pd(sign, left), _mm_andnot_pd(sign, right)));
+				unsigned uncertain = (unsigned)_mm_movemask_pd(_mm_cmplt_pd(_mm_andnot_pd(sign, dist), bound));
+				if (uncertain) {
+					double lane_dist[2];
+					_mm_storeu_pd(lane_dist, dist);
+					for (int lane = 0; lane < 2; lane++) {
+						if ((uncertain >> lane) & 1) {
+							lane_dist[lane] = Settle(lane_dist[lane], x[i + lane], y[i + lane], p1, p2);
+						}
+					}
+					dist = _mm_loadu_pd(lane_dist);
+				}
+				__m128d along = _mm_add_pd(_mm_mul_pd(dx, vex), _mm_mul_pd(dy, vey));
+
+				__m128d is_outside = _mm_cmpgt_pd(dist, zero);
+				outside += PopCount((unsigned)_mm_movemask_pd(is_outside));
+
+				__m128d tie = _mm_and_pd(_mm_cmpeq_pd(dist, best_dist), _mm_cmplt_pd(along, best_along));
+				__m128d better = _mm_and_pd(is_outside, _mm_or_pd(_mm_cmpgt_pd(dist, best_dist), tie));
+				// A lane that has not found anything yet takes any outside point.
+				better = _mm_or_pd(better, _mm_and_pd(is_outside, _mm_cmpeq_pd(best_dist, zero)));
+				best_dist = _mm_or_pd(_mm_and_pd(better, dist), _mm_andnot_pd(better, best_dist));
+				best_along = _mm_or_pd(_mm_and_pd(better, along), _mm_andnot_pd(better, best_along));
+				best_index = _mm_or_pd(_mm_and_pd(better, lane_index), _mm_andnot_pd(better, best_index));
+				lane_index = _mm_add_pd(lane_index, step);
+			}
+
+			double lane_dist[2], lane_along[2], lane_at[2];
+			_mm_storeu_pd(lane_dist, best_dist);
+			_mm_storeu_pd(lane_along, best_along);
+			_mm_storeu_pd(lane_at, best_index);
+
+			Best best = { 0, 0, 0 };
+			for (int lane = 0; lane < 2; lane++) {
+				if (lane_dist[lane] > 0) {
+					size_t at = (size_t)lane_at[lane];
+					if (best.dist == 0 || lane_dist[lane] > best.dist || (lane_dist[lane] == best.dist && (lane_along[lane] < best.along || (lane_along[lane] == best.along && at < best.index)))) {
+						best = Best{ lane_dist[lane], lane_along[lane], at };
+					}
+				}
+			}
+			ScanTail(x, y, i, n, p1, p2, ex, ey, best, outside);
+			return HullKernels::EdgeScan{ best.index, outside };
+		}
+
+		GEOMETRY_TARGET("avx2")
+		HullKernels::EdgeScan ScanEdgeAvx2(const double* x, const double* y, size_t n, const Point2D& p1, const Point2D& p2) {
+			const double ex = p2.x - p1.x;
+			const double ey = p2.y - p1.y;
+			const __m256d vx0 = _mm256_set1_pd(p1.x);
+			const __m256d vy0 = _mm256_set1_pd(p1.y);
+			const __m256d vex = _mm256_set1_pd(ex);
+			const __m256d vey = _mm256_set1_pd(ey);
+			const __m256d zero = _mm256_setzero_pd();
+			const __m256d sign = _mm256_set1_pd(-0.0);
+			const __m256d vbound = _mm256_set1_pd(Predicates::OrientErrorBound);
+
+			__m256d best_dist = zero;
+			__m256d best_along = zero;
+			__m256d best_index = zero;
+			__m256d lane_index = _mm256_set_pd(3.0, 2.0, 1.0, 0.0);
+			const __m256d step = _mm256_set1_pd(4.0);
+			size_t outside = 0;
+
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				__m256d dx = _mm256_sub_pd(_mm256_loadu_pd(x + i), vx0);
+				__m256d dy = _mm256_sub_pd(_mm256_loadu_pd(y + i), vy0);
+				__m256d left = _mm256_mul_pd(vex, dy);
+				__m256d right = _mm256_mul_pd(vey, dx);
+				__m256d dist = _mm256_sub_pd(zero, _mm256_sub_pd(left, right));
+				__m256d bound = _mm256_mul_pd(vbound, _mm256_add_pd(_mm256_andnot_pd(sign, left), _mm256_andnot_pd(sign, right)));
+				unsigned uncertain = (unsigned)_mm256_movemask_pd(_mm256_cmp_pd(_mm256_andnot_pd(sign, dist), bound, _CMP_LT_OQ));
+				if (uncertain) {
+					double lane_dist[4];
+					_mm256_storeu_pd(lane_dist, dist);
+					for (int lane = 0; lane < 4; lane++) {
+						if ((uncertain >> lane) & 1) {
+							lane_dist[lane] = Settle(lane_dist[lane], x[i + lane], y[i + lane], p1, p2);
+						}
+					}
+					dist = _mm256_loadu_pd(lane_dist);
+				}
+				__m256d along = _mm256_add_pd(_mm256_mul_pd(dx, vex), _mm256_mul_pd(dy, vey));
+
+				__m256d is_outside = _mm256_cmp_pd(dist, zero, _CMP_GT_OQ);
+				outside += PopCount((unsigned)_mm256_movemask_pd(is_outside));
+
+				__m256d tie = _mm256_and_pd(_mm256_cmp_pd(dist, best_dist, _CMP_EQ_OQ), _mm256_cmp_pd(along, best_along, _CMP_LT_OQ));
+				__m256d better = _mm256_and_pd(is_outside, _mm256_or_pd(_mm256_cmp_pd(dist, best_dist, _CMP_GT_OQ), tie));
+				better = _mm256_or_pd(better, _mm256_and_pd(is_outside, _mm256_cmp_pd(best_dist, zero, _CMP_EQ_OQ)));
+				best_dist = _mm256_blendv_pd(best_dist, dist, better);
+				best_along = _mm256_blendv_pd(best_along, along, better);
+				best_index = _mm256_blendv_pd(best_index, lane_index, better);
+				lane_index = _mm256_add_pd(lane_index, step);
+			}
+
+			double lane_dist[4], lane_along[4], lane_at[4];
+			_mm256_storeu_pd(lane_dist, best_dist);
+			_mm256_storeu_pd(lane_along, best_along);
+			_mm256_storeu_pd(lane_at, best_index);
+
+			Best best = { 0, 0, 0 };
+			for (int lane = 0; lane < 4; lane++) {
+				if (lane_dist[lane] > 0) {
+					size_t at = (size_t)lane_at[lane];
+					if (best.dist == 0 || lane_dist[lane] > best.dist || (lane_dist[lane] == best.dist && (lane_along[lane] < best.along || (lane_along[lane] == best.along && at < best.index)))) {
+						best = Best{ lane_dist[lane], lane_along[lane], at };
+					}
+				}
+			}
+			ScanTail(x, y, i, n, p1, p2, ex, ey, best, outside);
+			return HullKernels::EdgeScan{ best.index, outside };
+		}
+
+		// Branch-free compaction: every lane is written, but the output only advances for the ones kept.
+		inline size_t Compact(double* x, double* y, size_t kept, const double* lane_x, const double* lane_y, unsigned keep, int lanes) {
+			for (int lane = 0; lane < lanes; lane++) {
+				x[kept] = lane_x[lane];
+				y[kept] = lane_y[lane];
+				kept += (keep >> lane) & 1;
+			}
+			return kept;
+		}
+
+		/* Lanes that no edge put clearly outside but at least one edge could not decide go through the exact
+		test. Returns the corrected inside mask.
+		*/
+		inline unsigned SettleLanes(const PolygonEdges& edges, const double* lane_x, const double* lane_y, unsigned inside, unsigned uncertain, int lanes) {
+			for (int lane = 0; lane < lanes; lane++) {
+				if ((uncertain >> lane) & 1) {
+					if (!edges.Inside(lane_x[lane], lane_y[lane])) {
+						inside &= ~(1u << lane);
+					}
+				}
+			}
+			return inside;
+		}
+
+		GEOMETRY_TARGET("sse2")
+		size_t CullInsideSse2(double* x, double* y, size_t n, const Point2D* polygon, size_t corners) {
+			if (corners < 3) {
+				return n;
+			}
+			PolygonEdges edges(polygon, corners);
+			const __m128d zero = _mm_setzero_pd();
+			const __m128d sign = _mm_set1_pd(-0.0);
+			const __m128d vbound = _mm_set1_pd(Predicates::OrientErrorBound);
+			size_t kept = 0;
+			size_t i = 0;
+			for (; i + 2 <= n; i += 2) {
+				__m128d px = _mm_loadu_pd(x + i);
+				__m128d py = _mm_loadu_pd(y + i);
+				__m128d inside = _mm_cmpeq_pd(zero, zero);
+				__m128d uncertain = zero;
+				for (size_t e = 0; e < edges.count; e++) {
+					__m128d dx = _mm_sub_pd(px, _mm_set1_pd(edges.ox[e]));
+					__m128d dy = _mm_sub_pd(py, _mm_set1_pd(edges.oy[e]));
+					__m128d left = _mm_mul_pd(_mm_set1_pd(edges.ex[e]), dy);
+					__m128d right = _mm_mul_pd(_mm_set1_pd(edges.ey[e]), dx);
+					__m128d cross = _mm_sub_pd(left, right);
+					__m128d bound = _mm_mul_pd(vbound, _mm_add_pd(_mm_andnot_pd(sign, left), _mm_andnot_pd(sign, right)));
+					__m128d unsure = _mm_cmplt_pd(_mm_andnot_pd(sign, cross), bound);
+					inside = _mm_and_pd(inside, _mm_or_pd(_mm_cmpgt_pd(cross, zero), unsure));
+					uncertain = _mm_or_pd(uncertain, unsure);
+				}
+				double lane_x[2], lane_y[2];
+				_mm_storeu_pd(lane_x, px);
+				_mm_storeu_pd(lane_y, py);
+				unsigned inside_mask = (unsigned)_mm_movemask_pd(inside);
+				inside_mask = SettleLanes(edges, lane_x, lane_y, inside_mask, inside_mask & (unsigned)_mm_movemask_pd(uncertain), 2);
+				kept = Compact(x, y, kept, lane_x, lane_y, ~inside_mask, 2);
+			}
+			for (; i < n; i++) {
+				double px = x[i];
+				double py = y[i];
+				x[kept] = px;
+				y[kept] = py;
+				kept += edges.Inside(px, py) ? 0 : 1;
+			}
+			return kept;
+		}
+
+		GEOMETRY_TARGET("avx2")
+		size_t CullInsideAvx2(double* x, double* y, size_t n, const Point2D* polygon, size_t corners) {
+			if (corners < 3) {
+				return n;
+			}
+			PolygonEdges edges(polygon, corners);
+			__m256d ox[MaxCorners], oy[MaxCorners], ex[MaxCorners], ey[MaxCorners];
+			for (size_t e = 0; e < edges.count; e++) {
+				ox[e] = _mm256_set1_pd(edges.ox[e]);
+				oy[e] = _mm256_set1_pd(edges.oy[e]);
+				ex[e] = _mm256_set1_pd(edges.ex[e]);
+				ey[e] = _mm256_set1_pd(edges.ey[e]);
+			}
+			const __m256d zero = _mm256_setzero_pd();
+			const __m256d sign = _mm256_set1_pd(-0.0);
+			const __m256d vbound = _mm256_set1_pd(Predicates::OrientErrorBound);
+			size_t kept = 0;
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				__m256d px = _mm256_loadu_pd(x + i);
+				__m256d py = _mm256_loadu_pd(y + i);
+				__m256d inside = _mm256_cmp_pd(zero, zero, _CMP_EQ_OQ);
+				__m256d uncertain = zero;
+				for (size_t e = 0; e < edges.count; e++) {
+					__m256d dx = _mm256_sub_pd(px, ox[e]);
+					__m256d dy = _mm256_sub_pd(py, oy[e]);
+					__m256d left = _mm256_mul_pd(ex[e], dy);
+					__m256d right = _mm256_mul_pd(ey[e], dx);
+					__m256d cross = _mm256_sub_pd(left, right);
+					__m256d bound = _mm256_mul_pd(vbound, _mm256_add_pd(_mm256_andnot_pd(sign, left), _mm256_andnot_pd(sign, right)));
+					__m256d unsure = _mm256_cmp_pd(_mm256_andnot_pd(sign, cross), bound, _CMP_LT_OQ);
+					inside = _mm256_and_pd(inside, _mm256_or_pd(_mm256_cmp_pd(cross, zero, _CMP_GT_OQ), unsure));
+					uncertain = _mm256_or_pd(uncertain, unsure);
+				}
+				double lane_x[4], lane_y[4];
+				_mm256_storeu_pd(lane_x, px);
+				_mm256_storeu_pd(lane_y, py);
+				unsigned inside_mask = (unsigned)_mm256_movemask_pd(inside);
+				inside_mask = SettleLanes(edges, lane_x, lane_y, inside_mask, inside_mask & (unsigned)_mm256_movemask_pd(uncertain), 4);
+				kept = Compact(x, y, kept, lane_x, lane_y, ~inside_mask, 4);
+			}
+			for (; i < n; i++) {
+				double px = x[i];
+				double py = y[i];
+				x[kept] = px;
+				y[kept] = py;
+				kept += edges.Inside(px, py) ? 0 : 1;
+			}
+			return kept;
+		}
+
+		GEOMETRY_TARGET("sse2")
+		void MarkInsideSse2(const double* x, const double* y, size_t n, const Point2D* polygon, const Point2D* edges, size_t corners,
+			uint32_t bit, uint32_t* masks) {
+			const __m128d zero = _mm_setzero_pd();
+			const __m128d sign = _mm_set1_pd(-0.0);
+			const __m128d vbound = _mm_set1_pd(Predicates::OrientErrorBound);
+			Aabb box = BoundsOf(polygon, corners);
+			const __m128d min_x = _mm_set1_pd(box.min.x);
+			const __m128d min_y = _mm_set1_pd(box.min.y);
+			const __m128d max_x = _mm_set1_pd(box.max.x);
+			const __m128d max_y = _mm_set1_pd(box.max.y);
+			size_t i = 0;
+			for (; i + 2 <= n; i += 2) {
+				__m128d px = _mm_loadu_pd(x + i);
+				__m128d py = _mm_loadu_pd(y + i);
+				__m128d inside = _mm_and_pd(_mm_and_pd(_mm_cmpge_pd(px, min_x), _mm_cmple_pd(px, max_x)),
+					_mm_and_pd(_mm_cmpge_pd(py, min_y), _mm_cmple_pd(py, max_y)));
+				if (_mm_movemask_pd(inside) == 0) {
+					continue;
+				}
+				__m128d uncertain = zero;
+				for (size_t e = 0; e < corners; e++) {
+					__m128d dx = _mm_sub_pd(px, _mm_set1_pd(polygon[e].x));
+					__m128d dy = _mm_sub_pd(py, _mm_set1_pd(polygon[e].y));
+					__m128d left = _mm_mul_pd(_mm_set1_pd(edges[e].x), dy);
+					__m128d right = _mm_mul_pd(_mm_set1_pd(edges[e].y), dx);
+					__m128d cross = _mm_sub_pd(left, right);
+					__m128d bound = _mm_mul_pd(vbound, _mm_add_pd(_mm_andnot_pd(sign, left), _mm_andnot_pd(sign, right)));
+					__m128d unsure = _mm_cmplt_pd(_mm_andnot_pd(sign, cross), bound);
+					inside = _mm_and_pd(inside, _mm_or_pd(_mm_cmpge_pd(cross, zero), unsure));
+					uncertain = _mm_or_pd(uncertain, unsure);
+					if (_mm_movemask_pd(inside) == 0) {
+						break;
+					}
+				}
+				unsigned inside_mask = (unsigned)_mm_movemask_pd(inside);
+				if (inside_mask) {
+					MarkLanes(polygon, edges, corners, x + i, y + i, inside_mask, (unsigned)_mm_movemask_pd(uncertain), 2, bit, masks + i);
+				}
+			}
+			MarkInsideScalar(x + i, y + i, n - i, polygon, edges, corners, bit, masks + i);
+		}
+
+		GEOMETRY_TARGET("avx2")
+		void MarkInsideAvx2(const double* x, const double* y, size_t n, const Point2D* polygon, const Point2D* edges, size_t corners,
+			uint32_t bit, uint32_t* masks) {
+			const __m256d zero = _mm256_setzero_pd();
+			const __m256d sign = _mm256_set1_pd(-0.0);
+			const __m256d vbound = _mm256_set1_pd(Predicates::OrientErrorBound);
+			Aabb box = BoundsOf(polygon, corners);
+			const __m256d min_x = _mm256_set1_pd(box.min.x);
+			const __m256d min_y = _mm256_set1_pd(box.min.y);
+			const __m256d max_x = _mm256_set1_pd(box.max.x);
+			const __m256d max_y = _mm256_set1_pd(box.max.y);
+			size_t i = 0;
+			for (; i + 4 <= n; i += 4) {
+				__m256d px = _mm256_loadu_pd(x + i);
+				__m256d py = _mm256_loadu_pd(y + i);
+				__m256d inside = _mm256_and_pd(_mm256_and_pd(_mm256_cmp_pd(px, min_x, _CMP_GE_OQ), _mm256_cmp_pd(px, max_x, _CMP_LE_OQ)),
+					_mm256_and_pd(_mm256_cmp_pd(py, min_y, _CMP_GE_OQ), _mm256_cmp_pd(py, max_y, _CMP_LE_OQ)));
+				if (_mm256_movemask_pd(inside) == 0) {
+					continue;
+				}
+				__m256d uncertain = zero;
+				for (size_t e = 0; e < corners; e++) {
+					__m256d dx = _mm256_sub_pd(px, _mm256_broadcast_sd(&polygon[e].x));
+					__m256d dy = _mm256_sub_pd(py, _mm256_broadcast_sd(&polygon[e].y));
+					__m256d left = _mm256_mul_pd(_mm256_broadcast_sd(&edges[e].x), dy);
+					__m256d right = _mm256_mul_pd(_mm256_broadcast_sd(&edges[e].y), dx);
+					__m256d cross = _mm256_sub_pd(left, right);
+					__m256d bound = _mm256_mul_pd(vbound, _mm256_add_pd(_mm256_andnot_pd(sign, left), _mm256_andnot_pd(sign, right)));
+					__m256d unsure = _mm256_cmp_pd(_mm256_andnot_pd(sign, cross), bound, _CMP_LT_OQ);
+					inside = _mm256_and_pd(inside, _mm256_or_pd(_mm256_cmp_pd(cross, zero, _CMP_GE_OQ), unsure));
+					uncertain = _mm256_or_pd(uncertain, unsure);
+					if (_mm256_movemask_pd(inside) == 0) {
+						break;
+					}
+				}
+				unsigned inside_mask = (unsigned)_mm256_movemask_pd(inside);
+				if (inside_mask) {
+					MarkLanes(polygon, edges, corners, x + i, y + i, inside_mask, (unsigned)_mm256_movemask_pd(uncertain), 4, bit, masks + i);
+				}
+			}
+			MarkInsideScalar(x + i, y + i, n - i, polygon, edges, corners, bit, masks + i);
+		}
+
+		/* Batcher's odd-even merge sort as a list of compare-exchanges, a before b. For 16 inputs that is 63 of
+		them (the best known network has 60, but this one comes out of four nested loops instead of a table).
+		Other sizes are the network of the next power of two with every compare-exchange that touches a wire
+		past n left out; those would only ever compare against padding that sorts last, and never swap.
+		*/
+		struct Network {
+			uint8_t a[64];
+			uint8_t b[64];
+			size_t count;
+		};
+
+		constexpr Network Batcher(size_t n) {
+			Network network = {};
+			for (size_t p = 1; p < n; p <<= 1) {
+				for (size_t k = p; k >= 1; k >>= 1) {
+					for (size_t j = k % p; j + k < n; j += 2 * k) {
+						for (size_t i = 0; i < k && i + j + k < n; i++) {
+							if ((i + j) / (2 * p) == (i + j + k) / (2 * p)) {
+								network.a[network.count] = (uint8_t)(i + j);
+								network.b[network.count] = (uint8_t)(i + j + k);
+								network.count++;
+							}
+						}
+					}
+				}
+			}
+			return network;
+		}
+
+		constexpr Network Networks[HullKernels::MaxSmallHull + 1] = {
+			Batcher(0), Batcher(1), Batcher(2), Batcher(3), Batcher(4), Batcher(5), Batcher(6), Batcher(7), Batcher(8),
+			Batcher(9), Batcher(10), Batcher(11), Batcher(12), Batcher(13), Batcher(14), Batcher(15), Batcher(16)
+		};
+
+		const Network& NetworkFor(size_t n) {
+			return Networks[n];
+		}
+
+		// Two sets per register, and no blendv before SSE4.1: the swaps are and / andnot / or.
+		GEOMETRY_TARGET("sse2")
+		void SortSmallSetsSse2(double* x, double* y, size_t n) {
+			const Network& network = NetworkFor(n);
+			for (size_t half = 0; half < Sets; half += 2) {
+				__m128d vx[HullKernels::MaxSmallHull], vy[HullKernels::MaxSmallHull];
+				for (size_t k = 0; k < n; k++) {
+					vx[k] = _mm_loadu_pd(x + Sets * k + half);
+					vy[k] = _mm_loadu_pd(y + Sets * k + half);
+				}
+				for (size_t c = 0; c < network.count; c++) {
+					__m128d ax = vx[network.a[c]], ay = vy[network.a[c]];
+					__m128d bx = vx[network.b[c]], by = vy[network.b[c]];
+					__m128d swap = _mm_or_pd(_mm_cmplt_pd(bx, ax), _mm_and_pd(_mm_cmpeq_pd(bx, ax), _mm_cmplt_pd(by, ay)));
+					vx[network.a[c]] = _mm_or_pd(_mm_and_pd(swap, bx), _mm_andnot_pd(swap, ax));
+					vy[network.a[c]] = _mm_or_pd(_mm_and_pd(swap, by), _mm_andnot_pd(swap, ay));
+					vx[network.b[c]] = _mm_or_pd(_mm_and_pd(swap, ax), _mm_andnot_pd(swap, bx));
+					vy[network.b[c]] = _mm_or_pd(_mm_and_pd(swap, ay), _mm_andnot_pd(swap, by));
+				}
+				for (size_t k = 0; k < n; k++) {
+					_mm_storeu_pd(x + Sets * k + half, vx[k]);
+					_mm_storeu_pd(y + Sets * k + half, vy[k]);
+				}
+			}
+		}
+
+		GEOMETRY_TARGET("avx2")
+		void SortSmallSetsAvx2(double* x, double* y, size_t n) {
+			const Network& network = NetworkFor(n);
+			__m256d vx[HullKernels::MaxSmallHull], vy[HullKernels::MaxSmallHull];
+			for (size_t k = 0; k < n; k++) {
+				vx[k] = _mm256_loadu_pd(x + Sets * k);
+				vy[k] = _mm256_loadu_pd(y + Sets * k);
+			}
+			for (size_t c = 0; c < network.count; c++) {
+				__m256d ax = vx[network.a[c]], ay = vy[network.a[c]];
+				__m256d bx = vx[network.b[c]], by = vy[network.b[c]];
+				__m256d swap = _mm256_or_pd(_mm256_cmp_pd(bx, ax, _CMP_LT_OQ), _mm256_and_pd(_mm256_cmp_pd(bx, ax, _CMP_EQ_OQ), _mm256_cmp_pd(by, ay, _CMP_LT_OQ)));
+				vx[network.a[c]] = _mm256_blendv_pd(ax, bx, swap);
+				vy[network.a[c]] = _mm256_blendv_pd(ay, by, swap);
+				vx[network.b[c]] = _mm256_blendv_pd(bx, ax, swap);
+				vy[network.b[c]] = _mm256_blendv_pd(by, ay, swap);
+			}
+			for (size_t k = 0; k < n; k++) {
+				_mm256_storeu_pd(x + Sets * k, vx[k]);
+				_mm256_storeu_pd(y + Sets * k, vy[k]);
+			}
+		}
+
+		/* Only the sort runs in the lanes. The sweep pops a different number of points in every set, and a lock-step
+		version of it (test all four stack tops, pop where needed, repeat until no lane pops) came out slower than
+		just sweeping the sorted sets one by one.
+		*/
+		GEOMETRY_TARGET("sse2")
+		void SmallHullsSse2(double* x, double* y, size_t n, double* hull_x, double* hull_y, size_t* sizes) {
+			SortSmallSetsSse2(x, y, n);
+			HullLanes(x, y, n, hull_x, hull_y, sizes, true);
+		}
+
+		GEOMETRY_TARGET("avx2")
+		void SmallHullsAvx2(double* x, double* y, size_t n, double* hull_x, double* hull_y, size_t* sizes) {
+			SortSmallSetsAvx2(x, y, n);
+			HullLanes(x, y, n, hull_x, hull_y, sizes, true);
+		}
+
+		HullKernels::Isa DetectIsa() {
+#if defined(__GNUC__) || defined(__clang__)
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("avx2")) {
+				return HullKernels::Avx2;
+			}
+			if (__builtin_cpu_supports("sse2")) {
+				return HullKernels::Sse2;
+			}
+			return HullKernels::Scalar;
+#else
+			int info[4];
+			__cpuid(info, 0);
+			int max_leaf = info[0];
+			__cpuid(info, 1);
+			bool sse2 = (info[3] & (1 << 26)) != 0;
+			bool ymm_enabled = false;
+			if ((info[2] & (1 << 27)) && (info[2] & (1 << 28))) {
+				// OSXSAVE and AVX: the OS must also save the upper halves of the ymm registers.
+				ymm_enabled = (_xgetbv(0) & 6) == 6;
+			}
+			if (ymm_enabled && max_leaf >= 7) {
+				__cpuidex(info, 7, 0);
+				if (info[1] & (1 << 5)) {
+					return HullKernels::Avx2;
+				}
+			}
+			return sse2 ? HullKernels::Sse2 : HullKernels::Scalar;
+#endif
+		}
+
+#else
+
+		HullKernels::Isa DetectIsa() {
+			return HullKernels::Scalar;
+		}
+
+#endif
+
+		ScanEdgeFn ScanEdgeFor(HullKernels::Isa isa) {
+			switch (isa) {
+#if defined(GEOMETRY_X86)
+			case HullKernels::Avx2:
+				return ScanEdgeAvx2;
+			case HullKernels::Sse2:
+				return ScanEdgeSse2;
+#endif
+			default:
+				return ScanEdgeScalar;
+			}
+		}
+
+		CullInsideFn CullInsideFor(HullKernels::Isa isa) {
+			switch (isa) {
+#if defined(GEOMETRY_X86)
+			case HullKernels::Avx2:
+				return CullInsideAvx2;
+			case HullKernels::Sse2:
+				return CullInsideSse2;
+#endif
+			default:
+				return CullInsideScalar;
+			}
+		}
+
+		SmallHullsFn SmallHullsFor(HullKernels::Isa isa) {
+			switch (isa) {
+#if defined(GEOMETRY_X86)
+			case HullKernels::Avx2:
+				return SmallHullsAvx2;
+			case HullKernels::Sse2:
+				return SmallHullsSse2;
+#endif
+			default:
+				return SmallHullsScalar;
+			}
+		}
+
+		MarkInsideFn MarkInsideFor(HullKernels::Isa isa) {
+			switch (isa) {
+#if defined(GEOMETRY_X86)
+			case HullKernels::Avx2:
+				return MarkInsideAvx2;
+			case HullKernels::Sse2:
+				return MarkInsideSse2;
+#endif
+			default:
+				return MarkInsideScalar;
+			}
+		}
+
+		struct Dispatch {
+			HullKernels::Isa detected;
+			std::atomic<HullKernels::Isa> active;
+			std::atomic<ScanEdgeFn> scan_edge;
+			std::atomic<CullInsideFn> cull_inside;
+			std::atomic<SmallHullsFn> small_hulls;
+			std::atomic<MarkInsideFn> mark_inside;
+
+			Dispatch() : detected(DetectIsa()), active(detected), scan_edge(ScanEdgeFor(detected)), cull_inside(CullInsideFor(detected)), small_hulls(SmallHullsFor(detected)),
+				mark_inside(MarkInsideFor(detected)) {
+			}
+		};
+
+		Dispatch& Kernels() {
+			static Dispatch dispatch;
+			return dispatch;
+		}
+	}
+
+	HullKernels::EdgeScan HullKernels::ScanEdge(const double* x, const double* y, size_t n, const Point2D& p1, const Point2D& p2) {
+		return Kernels().scan_edge.load(std::memory_order_relaxed)(x, y, n, p1, p2);
+	}
+
+	size_t HullKernels::CullInside(double* x, double* y, size_t n, const Point2D* polygon, size_t corners) {
+		return Kernels().cull_inside.load(std::memory_order_relaxed)(x, y, n, polygon, corners);
+	}
+
+	void HullKernels::SmallHulls(double* x, double* y, size_t n, double* hull_x, double* hull_y, size_t* sizes) {
+		Kernels().small_hulls.load(std::memory_order_relaxed)(x, y, n, hull_x, hull_y, sizes);
+	}
+
+	void HullKernels::MarkInside(const double* x, const double* y, size_t n, const Point2D* polygon, const Point2D* edges, size_t corners,
+		uint32_t bit, uint32_t* masks) {
+		Kernels().mark_inside.load(std::memory_order_relaxed)(x, y, n, polygon, edges, corners, bit, masks);
+	}
+
+	HullKernels::Isa HullKernels::Detect() {
+		return Kernels().detected;
+	}
+
+	void HullKernels::Select(Isa isa) {
+		Dispatch& dispatch = Kernels();
+		if (isa > dispatch.detected) {
+			isa = dispatch.detected;
+		}
+		dispatch.active = isa;
+		dispatch.scan_edge = ScanEdgeFor(isa);
+		dispatch.cull_inside = CullInsideFor(isa);
+		dispatch.small_hulls = SmallHullsFor(isa);
+		dispatch.mark_inside = MarkInsideFor(isa);
+	}
+
+	HullKernels::Isa HullKernels::Active() {
+		return Kernels().active;
+	}
+
+	const char* HullKernels::Name(Isa isa) {
+		switch (isa) {
+		case Avx2:
+			return "avx2";
+		case Sse2:
+			return "sse2";
+		default:
+			return "scalar";
+		}
+	}
+}
@@ -0,0 +1,75 @@
+#ifndef _GEOMETRY_HULLKERNELS_H
+#define _GEOMETRY_HULLKERNELS_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Point2D.h"
+
+namespace Geometry {
+
+	/* Vectorized inner loops of the hull engines, over structure-of-arrays x / y buffers.
+
+	Each kernel exists as AVX2, SSE2 and plain scalar code. The widest one the CPU supports is picked at
+	runtime the first time a kernel is used; Select() can force a narrower one (for benchmarks). All three
+	do the arithmetic in the same order without FMA, so they return bit-identical results.
+
+	Inside / outside decisions are exact: every lane carries the Predicates error bound along, and the rare
+	lanes whose cross product is too close to zero to trust are decided again by Predicates::Orient2D.
+	*/
+	class HullKernels {
+
+	public:
+		enum Isa {
+			Scalar,
+			Sse2,
+			Avx2
+		};
+
+		struct EdgeScan {
+			size_t farthest;	// Index of the point farthest to the right of the edge. Only valid if outside > 0.
+			size_t outside;		// How many points are strictly to the right of the edge.
+		};
+
+		/* One pass over x[0, n) / y[0, n) against the directed edge p1 -> p2: signed distance (the cross product),
+		side classification and the argmax of the distance over the points strictly to the right.
+		Ties go to the point closest to p1 along the edge, then to the lowest index, like the scalar QuickHull loop.
+		*/
+		static EdgeScan ScanEdge(const double* x, const double* y, size_t n, const Point2D& p1, const Point2D& p2);
+
+		/* Drops the points strictly inside a convex polygon (counterclockwise, at most 8 corners, no repeated
+		corners) by compacting x[0, n) / y[0, n) in place; returns how many are left. Points on the boundary stay.
+		*/
+		static size_t CullInside(double* x, double* y, size_t n, const Point2D* polygon, size_t corners);
+
+		/* ORs bit into masks[i] for every point (x[i], y[i]) inside the convex polygon (counterclockwise, at least
+		3 corners, any number of them) or on its boundary. edges[k] is polygon[k + 1] - polygon[k], wrapping
+		around, worked out once by the caller. The polygon's bounds are tested first, and lanes stop testing
+		edges once all of them are out.
+		*/
+		static void MarkInside(const double* x, const double* y, size_t n, const Point2D* polygon, const Point2D* edges, size_t corners,
+			uint32_t bit, uint32_t* masks);
+
+		/* Hulls of SmallHullLanes small sets of n points each at once (n at most MaxSmallHull), the same as
+		MonotoneChain gives for each. The sets are interleaved, point k of set s is x[SmallHullLanes * k + s] /
+		y[SmallHullLanes * k + s]; the vector kernels sort them in place with a fixed sorting network, the same
+		compare-exchanges whatever the data, so the sets run side by side in the lanes. Hull s is written
+		interleaved the same way to hull_x / hull_y, which need room for SmallHullLanes * (n + 1) values; sizes[s]
+		is its vertex count.
+		*/
+		static const size_t SmallHullLanes = 4;
+		static const size_t MaxSmallHull = 16;
+		static void SmallHulls(double* x, double* y, size_t n, double* hull_x, double* hull_y, size_t* sizes);
+
+		// Widest ISA this CPU (and OS) supports.
+		static Isa Detect();
+
+		// Forces a kernel set. Anything wider than Detect() is clamped to it. Not meant to be called while kernels run.
+		static void Select(Isa isa);
+		static Isa Active();
+		static const char* Name(Isa isa);
+	};
+}
+
+#endif
@@ -0,0 +1,237 @@
+#include "HullMath.h"
+
+#include <algorithm>
+
+#include "Gjk.h"
+#include "Predicates.h"
+#include "SupportShape.h"
+
+namespace Geometry {
+
+	namespace {
+
+		// 0 for directions in the half-turn after straight down (x > 0, or straight up), 1 for the other half.
+		// The sign of a difference of doubles is exact, so this never misfiles an edge.
+		int Half(const Point2D& tip, const Point2D& tail) {
+			return (tip.x > tail.x || (tip.x == tail.x && tip.y > tail.y)) ? 0 : 1;
+		}
+
+		size_t RightmostIndex(const Point2D* hull, size_t n) {
+			size_t i = 0;
+			while (i + 1 < n && (hull[i].x < hull[i + 1].x || (hull[i].x == hull[i + 1].x && hull[i].y < hull[i + 1].y))) {
+				i++;
+			}
+			return i;
+		}
+
+		/* hull1 + hull2, or hull1 - hull2 with negate. Going counterclockwise from its lowest-x point, a hull's
+		edges turn through one full circle starting just after straight down, so both edge lists are sorted by
+		that angle and the sum's edges are their merge. Its first vertex is the sum of the two first vertices.
+		Angles are compared by half-turn, then by the exact cross product, so parallel edges merge into one.
+
+		-hull2 keeps the vertex order of hull2 (a point reflection is a rotation), starts where hull2 is
+		rightmost, and its edges are hull2's backwards, which only swaps tip and tail.
+		*/
+		size_t EdgeMerge(const Point2D* hull1, size_t n1, const Point2D* hull2, size_t n2, bool negate, Point2D* out) {
+			if (n1 == 0 || n2 == 0) {
+				return 0;
+			}
+			const size_t start = negate ? RightmostIndex(hull2, n2) : 0;
+			const size_t edges1 = n1 > 1 ? n1 : 0;
+			const size_t edges2 = n2 > 1 ? n2 : 0;
+			auto vertex2 = [&](size_t j) {
+				const Point2D& p = hull2[(start + j) % n2];
+				return negate ? Point2D{ -p.x, -p.y } : p;
+			};
+
+			size_t i = 0;
+			size_t j = 0;
+			size_t count = 0;
+			while (i < edges1 || j < edges2) {
+				out[count++] = hull1[i % n1] + vertex2(j);
+				if (j == edges2) {
+					i++;
+					continue;
+				}
+				if (i == edges1) {
+					j++;
+					continue;
+				}
+
+				const Point2D& tip1 = hull1[(i + 1) % n1];
+				const Point2D& tail1 = hull1[i];
+				const Point2D& from2 = hull2[(start + j) % n2];
+				const Point2D& to2 = hull2[(start + j + 1) % n2];
+				const Point2D& tip2 = negate ? from2 : to2;
+				const Point2D& tail2 = negate ? to2 : from2;
+
+				int half1 = Half(tip1, tail1);
+				int half2 = Half(tip2, tail2);
+				int turn = half1 != half2 ? half2 - half1 : Predicates::CrossSign(tip1, tail1, tip2, tail2);
+				if (turn >= 0) {
+					i++;
+				}
+				if (turn <= 0) {
+					j++;
+				}
+			}
+			if (count == 0) {
+				out[count++] = hull1[0] + vertex2(0);
+			}
+			return count;
+		}
+	}
+
+	bool HullMath::onLine(const Point2D& end_1, const Point2D& end_2, const Point2D& point) {
+		if (end_1.x <= std::max(point.x, end_2.x) && end_1.x >= std::min(point.x, end_2.x) && end_1.y <= std::max(point.y, end_2.y) && end_1.y >= std::min(point.y, end_2.y)) {
+			return true;
+		}
+		return false;
+	}
+
+	int HullMath::PointOri(const Point2D& p1, const Point2D& p2, const Point2D& p3) {
+		int turn = Predicates::Orient2D(p1, p2, p3);
+
+		if (turn == 0) {
+			return 0;
+		}
+		return (turn < 0) ? 1 : 2;
+	}
+
+	double HullMath::PointDistance(const Point2D& p1, const Point2D& p2) {
+		return (p1.x - p2.x) * (p1.x - p2.x) + (p1.y - p2.y) * (p1.y - p2.y);
+	}
+
+	bool HullMath::isLeft(const Point2D& end_1, const Point2D& end_2, const Point2D& point) {
+		return Predicates::Orient2D(end_1, end_2, point) > 0;
+	}
+
+	bool HullMath::LineIntersects(const Point2D& end_11, const Point2D& end_12, const Point2D& end_21, const Point2D& end_22) {
+		int o1 = PointOri(end_11, end_12, end_21);
+		int o2 = PointOri(end_11, end_12, end_22);
+		int o3 = PointOri(end_21, end_22, end_11);
+		int o4 = PointOri(end_21, end_22, end_12);
+
+		if (o1 != o2 && o3 != o4) {
+			return true;
+		}
+
+		if (o1 == 0 && onLine(end_11, end_21, end_12)) {
+			return true;
+		}
+
+		if (o2 == 0 && onLine(end_11, end_22, end_12)) {
+			return true;
+		}
+
+		if (o3 == 0 && onLine(end_21, end_11, end_22)) {
+			return true;
+		}
+
+		if (o4 == 0 && onLine(end_21, end_12, end_22)) {
+			return true;
+		}
+
+		return false;
+	}
+
+	bool HullMath::ContainsPoint(const std::vector<Point2D>& hull, const Point2D& point) {
+		return ContainsPoint(hull.data(), hull.size(), point);
+	}
+
+	/* Past the first and last spoke (hull[0] to hull[1], hull[0] to hull[n - 1]) the point is outside. In
+	between, the spokes turn counterclockwise, so the point is left of the spokes up to some hull[low] and right
+	of the rest; it is in the triangle hull[0], hull[low], hull[low + 1] iff it is left of that triangle's outer
+	edge. Points on the first or last spoke come out right too: the search ends at the triangle that has it.
+	*/
+	bool HullMath::ContainsPoint(const Point2D* hull, size_t n, const Point2D& point) {
+		if (n == 0) {
+			return false;
+		}
+		if (n == 1) {
+			return hull[0] == point;
+		}
+		if (n == 2) {
+			return Predicates::Orient2D(hull[0], hull[1], point) == 0 && Predicates::DotSign(hull[0], point, hull[1], point) <= 0;
+		}
+
+		const Point2D& pivot = hull[0];
+		if (Predicates::Orient2D(pivot, hull[1], point) < 0 || Predicates::Orient2D(pivot, hull[n - 1], point) > 0) {
+			return false;
+		}
+		size_t low = 1;
+		size_t high = n - 1;
+		while (high - low > 1) {
+			size_t middle = low + (high - low) / 2;
+			if (Predicates::Orient2D(pivot, hull[middle], point) >= 0) {
+				low = middle;
+			}
+			else {
+				high = middle;
+			}
+		}
+		return Predicates::Orient2D(hull[low], hull[low + 1], point) >= 0;
+	}
+
+	bool HullMath::HullsIntersecting(const std::vector<Point2D>& hull1, const std::vector<Point2D>& hull2) {
+		if (hull1.empty() || hull2.empty()) {
+			return false;
+		}
+		PolygonShape first(hull1);
+		PolygonShape second(hull2);
+		return Gjk::Intersecting(first, second);
+	}
+
+	bool HullMath::EdgesIntersecting(const std::vector<Point2D>& hull1, const std::vector<Point2D>& hull2) {
+		for (size_t i = 0; i < hull1.size(); i++) {
+			for (size_t j = 0; j < hull2.size(); j++) {
+				if (LineIntersects(hull1[i], hull1[(i + 1) % hull1.size()], hull2[j], hull2[(j + 1) % hull2.size()])) {
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	std::vector<Point2D> HullMath::MinkowskiSum(const std::vector<Point2D>& hull1, const std::vector<Point2D>& hull2) {
+		std::vector<Point2D> sum;
+		sum.reserve(hull1.size() * hull2.size());
+		for (size_t i = 0; i < hull1.size(); i++) {
+			for (size_t j = 0; j < hull2.size(); j++) {
+				sum.push_back(hull1[i] + hull2[j]);
+			}
+		}
+		return sum;
+	}
+
+	std::vector<Point2D> HullMath::MinkowskiDiff(const std::vector<Point2D>& hull1, const std::vector<Point2D>& hull2) {
+		std::vector<Point2D> diff;
+		diff.reserve(hull1.size() * hull2.size());
+		for (size_t i = 0; i < hull1.size(); i++) {
+			for (size_t j = 0; j < hull2.size(); j++) {
+				diff.push_back(hull1[i] - hull2[j]);
+			}
+		}
+		return diff;
+	}
+
+	std::vector<Point2D> HullMath::ConvexMinkowskiSum(const std::vector<Point2D>& hull1, const std::vector<Point2D>& hull2) {
+		std::vector<Point2D> sum(hull1.size() + hull2.size());
+		sum.resize(EdgeMerge(hull1.data(), hull1.size(), hull2.data(), hull2.size(), false, sum.data()));
+		return sum;
+	}
+
+	std::vector<Point2D> HullMath::ConvexMinkowskiDiff(const std::vector<Point2D>& hull1, const std::vector<Point2D>& hull2) {
+		std::vector<Point2D> diff(hull1.size() + hull2.size());
+		diff.resize(EdgeMerge(hull1.data(), hull1.size(), hull2.data(), hull2.size(), true, diff.data()));
+		return diff;
+	}
+
+	size_t HullMath::ConvexMinkowskiSum(const Point2D* hull1, size_t n1, const Point2D* hull2, size_t n2, Point2D* out) {
+		return EdgeMerge(hull1, n1, hull2, n2, false, out);
+	}
+
+	size_t HullMath::ConvexMinkowskiDiff(const Point2D* hull1, size_t n1, const Point2D* hull2, size_t n2, Point2D* out) {
+		return EdgeMerge(hull1, n1, hull2, n2, true, out);
+	}
+}
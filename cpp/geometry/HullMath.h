@@ -0,0 +1,64 @@
+#ifndef _GEOMETRY_HULLMATH_H
+#define _GEOMETRY_HULLMATH_H
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace Geometry {
+
+	class HullMath {
+
+	public:
+
+		// Check if a point is on an edge
+		static bool onLine(const Point2D& end_1, const Point2D& end_2, const Point2D& point);
+
+		// 0 if collinear, 1 and 2 for the two turning directions (same convention as the window code always used).
+		static int PointOri(const Point2D& p1, const Point2D& p2, const Point2D& p3);
+
+		// Squared distance between two points.
+		static double PointDistance(const Point2D& p1, const Point2D& p2);
+
+		// Determine if a point is to the left of an edge using a cross product!
+		// end_1 and end_2 are the endpoints of the edge (going counterclockwise, ideally)
+		static bool isLeft(const Point2D& end_1, const Point2D& end_2, const Point2D& point);
+
+		static bool LineIntersects(const Point2D& end_11, const Point2D& end_12, const Point2D& end_21, const Point2D& end_22);
+
+		/* Whether the point is inside the hull or on its boundary, in O(log n): a binary search for the wedge of
+		the fan from hull[0] the point is in, then one test against that wedge's outer edge. Exact. Any convex
+		counterclockwise polygon without repeated or collinear vertices will do, whatever vertex it starts at;
+		one or two points are a point or a segment. For many queries on one hull, see ConvexHullLocator.
+		*/
+		static bool ContainsPoint(const std::vector<Point2D>& hull, const Point2D& point);
+		static bool ContainsPoint(const Point2D* hull, size_t n, const Point2D& point);
+
+		/* Whether two hulls overlap (touching counts), by GJK on their difference: O(n + m) a step, a few steps,
+		and right when one hull is inside the other too.
+		*/
+		static bool HullsIntersecting(const std::vector<Point2D>& hull1, const std::vector<Point2D>& hull2);
+
+		// The old way: every edge of hull1 against every edge of hull2, O(n m). Misses containment. Kept to compare.
+		static bool EdgesIntersecting(const std::vector<Point2D>& hull1, const std::vector<Point2D>& hull2);
+
+		// All pairwise sums / differences. Run the result through QuickHull to get the actual Minkowski hull.
+		static std::vector<Point2D> MinkowskiSum(const std::vector<Point2D>& hull1, const std::vector<Point2D>& hull2);
+		static std::vector<Point2D> MinkowskiDiff(const std::vector<Point2D>& hull1, const std::vector<Point2D>& hull2);
+
+		/* Minkowski hull of two hulls (the usual contract) in O(n + m): both edge lists are already sorted by
+		angle, so merging them walks the result's edges in order and every vertex comes out once. The result
+		is a hull too, starting at its lowest-x point. The difference is hull1 + (-hull2).
+		*/
+		static std::vector<Point2D> ConvexMinkowskiSum(const std::vector<Point2D>& hull1, const std::vector<Point2D>& hull2);
+		static std::vector<Point2D> ConvexMinkowskiDiff(const std::vector<Point2D>& hull1, const std::vector<Point2D>& hull2);
+
+		// Same, written to out (room for n1 + n2 points) without allocating. Returns the vertex count.
+		static size_t ConvexMinkowskiSum(const Point2D* hull1, size_t n1, const Point2D* hull2, size_t n2, Point2D* out);
+		static size_t ConvexMinkowskiDiff(const Point2D* hull1, size_t n1, const Point2D* hull2, size_t n2, Point2D* out);
+	};
+}
+
+#endif
@@ -0,0 +1,169 @@
+#include "MergeHull.h"
+
+#include <algorithm>
+
+#include "MonotoneChain.h"
+#include "Predicates.h"
+#include "TaskPool.h"
+
+namespace Geometry {
+
+	namespace {
+
+		// Splits stop here; MonotoneChain takes over.
+		const size_t LeafPoints = 4096;
+
+		// Smaller splits are not worth a task.
+		const size_t ParallelPoints = 65536;
+
+		bool LexLess(const Point2D& a, const Point2D& b) {
+			return a.x < b.x || (a.x == b.x && a.y < b.y);
+		}
+
+		// The lower chain runs from hull[0] up to the rightmost vertex in x-then-y order; the upper chain comes back.
+		size_t RightmostIndex(const std::vector<Point2D>& hull) {
+			size_t i = 0;
+			while (i + 1 < hull.size() && LexLess(hull[i], hull[i + 1])) {
+				i++;
+			}
+			return i;
+		}
+
+		/* left lies entirely before right (its rightmost vertex is at most right[0]). Both bridges start out between
+		the facing extreme points, left's rightmost vertex and right[0], and move outwards while the turn at either
+		end is not strictly to the left, the same test the monotone chain pops on. Each end only ever moves one way,
+		so that is O(n + m) however they alternate. What is left at both ends of both bridges is a strict left turn,
+		and the outer chains are convex already, so the joined polygon is the hull.
+
+		Lower bridge: left[i] -> right[j], i walking back down left's lower chain, j up right's lower chain.
+		Upper bridge: right[k] -> left[l], k walking back down right's upper chain, l up left's upper chain; index
+		m stands for right[0] and n for left[0], where the upper chains end.
+		*/
+		std::vector<Point2D> Bridge(const std::vector<Point2D>& left, const std::vector<Point2D>& right) {
+			const size_t n = left.size();
+			const size_t m = right.size();
+			const size_t left_max = RightmostIndex(left);
+			const size_t right_max = RightmostIndex(right);
+			auto l_at = [&](size_t index) -> const Point2D& { return left[index == n ? 0 : index]; };
+			auto r_at = [&](size_t index) -> const Point2D& { return right[index == m ? 0 : index]; };
+
+			size_t i = left_max;
+			size_t j = 0;
+			for (bool moved = true; moved;) {
+				moved = false;
+				while (i > 0 && Predicates::Orient2D(left[i - 1], left[i], right[j]) <= 0) {
+					i--;
+					moved = true;
+				}
+				while (j < right_max && Predicates::Orient2D(left[i], right[j], right[j + 1]) <= 0) {
+					j++;
+					moved = true;
+				}
+			}
+
+			size_t k = m;
+			size_t l = left_max;
+			for (bool moved = true; moved;) {
+				moved = false;
+				while (k > right_max && Predicates::Orient2D(right[k - 1], r_at(k), l_at(l)) <= 0) {
+					k--;
+					moved = true;
+				}
+				while (l < n && Predicates::Orient2D(r_at(k), l_at(l), l_at(l + 1)) <= 0) {
+					l++;
+					moved = true;
+				}
+			}
+
+			// left[0, i], right[j, k], left[l, n). A shared end point (both hulls a single point) only goes in once.
+			std::vector<Point2D> hull;
+			hull.reserve((i + 1) + (k - j + 1) + (n - l));
+			hull.insert(hull.end(), left.begin(), left.begin() + i + 1);
+			for (size_t r = j; r <= k; r++) {
+				if (r < m || j > 0) {
+					hull.push_back(r_at(r));
+				}
+			}
+			for (size_t r = l; r < n; r++) {
+				if (r != i) {
+					hull.push_back(left[r]);
+				}
+			}
+			if (hull.size() == 2 && hull[0] == hull[1]) {
+				hull.resize(1);
+			}
+			return hull;
+		}
+
+		// Vertices of hull in x-then-y order: the lower chain, then the upper chain backwards.
+		Point2D* SortedVertices(const std::vector<Point2D>& hull, Point2D* out) {
+			const size_t right_max = RightmostIndex(hull);
+			return std::merge(hull.begin(), hull.begin() + right_max + 1, hull.rbegin(), hull.rend() - (right_max + 1), out, LexLess);
+		}
+
+		/* Overlapping hulls: both vertex lists in x order, merged, swept once. One allocation holds the output at the
+		front (the chain needs n + m + 1 points for its stack), then the merged list, then the two sorted lists.
+		*/
+		std::vector<Point2D> Sweep(const std::vector<Point2D>& a, const std::vector<Point2D>& b) {
+			const size_t total = a.size() + b.size();
+			std::vector<Point2D> hull(3 * total + 1);
+			Point2D* merged = hull.data() + total + 1;
+			Point2D* sorted_a = merged + total;
+			Point2D* sorted_b = SortedVertices(a, sorted_a);
+			Point2D* end = SortedVertices(b, sorted_b);
+			std::merge(sorted_a, sorted_b, sorted_b, end, merged, LexLess);
+			hull.resize(MonotoneChain::ChainSorted(merged, total, hull.data()));
+			return hull;
+		}
+
+		std::vector<Point2D> Build(Point2D* points, size_t n, TaskPool* pool) {
+			if (n <= LeafPoints) {
+				std::vector<Point2D> hull(n + 1);
+				hull.resize(MonotoneChain::GetConvexHull(points, n, hull.data()));
+				return hull;
+			}
+
+			const size_t half = n / 2;
+			std::vector<Point2D> left;
+			std::vector<Point2D> right;
+			if (pool && n >= ParallelPoints) {
+				TaskGroup group(*pool);
+				group.Run([&]() { left = Build(points, half, pool); });
+				right = Build(points + half, n - half, pool);
+				group.Wait();
+			}
+			else {
+				left = Build(points, half, pool);
+				right = Build(points + half, n - half, pool);
+			}
+			return MergeHull::Merge(left, right);
+		}
+	}
+
+	std::vector<Point2D> MergeHull::Merge(const std::vector<Point2D>& a, const std::vector<Point2D>& b) {
+		if (a.empty()) {
+			return b;
+		}
+		if (b.empty()) {
+			return a;
+		}
+		if (!LexLess(b[0], a[RightmostIndex(a)])) {
+			return Bridge(a, b);
+		}
+		if (!LexLess(a[0], b[RightmostIndex(b)])) {
+			return Bridge(b, a);
+		}
+		return Sweep(a, b);
+	}
+
+	// The leaves sort their slice of the points in place, so they get a copy.
+	std::vector<Point2D> MergeHull::GetConvexHull(const std::vector<Point2D>& points) {
+		std::vector<Point2D> work(points);
+		return Build(work.data(), work.size(), nullptr);
+	}
+
+	std::vector<Point2D> MergeHull::GetConvexHull(const std::vector<Point2D>& points, TaskPool& pool) {
+		std::vector<Point2D> work(points);
+		return Build(work.data(), work.size(), &pool);
+	}
+}
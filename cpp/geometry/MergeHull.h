@@ -0,0 +1,38 @@
+#ifndef _GEOMETRY_MERGEHULL_H
+#define _GEOMETRY_MERGEHULL_H
+#pragma once
+
+#include <vector>
+
+#include "Point2D.h"
+
+namespace Geometry {
+
+	class TaskPool;
+
+	/* Hull of the union of two hulls in linear time, and the divide and conquer engine built on it.
+
+	Merge takes two hulls with the usual contract and returns the hull of all their vertices in O(n + m). If one
+	hull lies entirely before the other in x-then-y order (they may share that one extreme point), it walks the
+	lower and upper tangents (bridges) between them from the facing extreme points, and the result is the two
+	outer chains joined by the bridges. Hulls that overlap in x are read out in x order instead (each one's
+	lower chain and reversed upper chain are already sorted, so that is a merge, not a sort) and swept once
+	by the monotone chain.
+
+	GetConvexHull splits the points into halves down to a few thousand, hulls those with MonotoneChain and
+	merges back up. The pool version runs both halves of every big split in parallel, the merges included.
+
+	Same contract as the other engines: counterclockwise (y up), starting at the lowest-x point, no collinear
+	points or duplicates.
+	*/
+	class MergeHull {
+
+	public:
+		static std::vector<Point2D> Merge(const std::vector<Point2D>& a, const std::vector<Point2D>& b);
+
+		static std::vector<Point2D> GetConvexHull(const std::vector<Point2D>& points);
+		static std::vector<Point2D> GetConvexHull(const std::vector<Point2D>& points, TaskPool& pool);
+	};
+}
+
+#endif
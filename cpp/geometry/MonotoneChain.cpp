@@ -0,0 +1,73 @@
+#include "MonotoneChain.h"
+
+#include <algorithm>
+
+#include "Predicates.h"
+
+namespace Geometry {
+
+	/* The sorted copy and the hull share a single allocation of 2n + 1 points: the sorted points sit in the back
+	half and the hull stack grows from the front. The stack never holds more than n + 1 points, so it cannot
+	run into the sorted point it is about to read.
+	*/
+	std::vector<Point2D> MonotoneChain::GetConvexHull(const std::vector<Point2D>& points) {
+		const size_t n = points.size();
+		std::vector<Point2D> hull;
+		if (n == 0) {
+			return hull;
+		}
+
+		hull.resize(2 * n + 1);
+		Point2D* sorted = hull.data() + n + 1;
+		std::copy(points.begin(), points.end(), sorted);
+		hull.resize(GetConvexHull(sorted, n, hull.data()));
+		return hull;
+	}
+
+	size_t MonotoneChain::GetConvexHull(Point2D* points, size_t n, Point2D* out) {
+		if (n == 0) {
+			return 0;
+		}
+
+		Point2D* sorted = points;
+		std::sort(sorted, sorted + n, [](const Point2D& a, const Point2D& b) {
+			return a.x < b.x || (a.x == b.x && a.y < b.y);
+		});
+		return ChainSorted(sorted, n, out);
+	}
+
+	size_t MonotoneChain::ChainSorted(const Point2D* sorted, size_t n, Point2D* out) {
+		if (n == 0) {
+			return 0;
+		}
+
+		Point2D* stack = out;
+		size_t k = 0;
+
+		// Lower hull, left to right.
+		for (size_t i = 0; i < n; i++) {
+			while (k >= 2 && Predicates::Orient2D(stack[k - 2], stack[k - 1], sorted[i]) <= 0) {
+				k--;
+			}
+			stack[k++] = sorted[i];
+		}
+
+		// Upper hull, right to left. The rightmost point is already on the stack.
+		const size_t lower = k + 1;
+		for (size_t i = n - 1; i-- > 0;) {
+			while (k >= lower && Predicates::Orient2D(stack[k - 2], stack[k - 1], sorted[i]) <= 0) {
+				k--;
+			}
+			stack[k++] = sorted[i];
+		}
+
+		// The last point pushed is the first one again (or the only one, if all points coincide).
+		if (k > 1) {
+			k--;
+		}
+		if (k == 2 && stack[0] == stack[1]) {
+			k = 1;
+		}
+		return k;
+	}
+}
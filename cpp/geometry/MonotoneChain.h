@@ -0,0 +1,34 @@
+#ifndef _GEOMETRY_MONOTONECHAIN_H
+#define _GEOMETRY_MONOTONECHAIN_H
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace Geometry {
+
+	/* Andrew's monotone chain. Sorts the points by x (then y) once and sweeps the lower hull left to right
+	and the upper hull right to left, so the result comes out already ordered: counterclockwise (y up),
+	starting at the lowest-x point, without collinear points or duplicates. No sorting pass afterwards.
+	*/
+	class MonotoneChain {
+
+	public:
+		static std::vector<Point2D> GetConvexHull(const std::vector<Point2D>& points);
+
+		/* Same hull, without allocating: sorts points[0, n) in place and writes the hull to out, which needs room
+		for n + 1 points and may not overlap points. Returns the number of hull vertices. For callers that build
+		lots of small hulls out of one flat buffer (see ChanHull).
+		*/
+		static size_t GetConvexHull(Point2D* points, size_t n, Point2D* out);
+
+		/* Just the two sweeps, for points[0, n) that are sorted by x then y already (see BatchHull). Same output
+		and room needed as above.
+		*/
+		static size_t ChainSorted(const Point2D* sorted, size_t n, Point2D* out);
+	};
+}
+
+#endif
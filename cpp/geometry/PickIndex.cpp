@@ -0,0 +1,180 @@
+#include "PickIndex.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Geometry {
+
+	namespace {
+
+		bool Inside(int32_t x, int32_t y, int32_t x0, int32_t y0, int32_t x1, int32_t y1) {
+			return x0 <= x && x <= x1 && y0 <= y && y <= y1;
+		}
+
+		void Erase(std::vector<PickIndex::Id>& cell, PickIndex::Id id) {
+			auto at = std::find(cell.begin(), cell.end(), id);
+			*at = cell.back();
+			cell.pop_back();
+		}
+	}
+
+	PickIndex::PickIndex(double cell_size) : inverse(1.0 / cell_size), next_order(0), count(0) {}
+
+	int32_t PickIndex::Coordinate(double value) const {
+		return (int32_t)std::floor(value * inverse);
+	}
+
+	void PickIndex::Insert(Id id, const Point2D& center, double radius) {
+		Aabb box = { Point2D{ center.x - radius, center.y - radius }, Point2D{ center.x + radius, center.y + radius } };
+		Place(id, box, center, radius);
+	}
+
+	void PickIndex::Insert(Id id, const Aabb& box) {
+		Place(id, box, box.min, 0);
+	}
+
+	void PickIndex::Place(Id id, const Aabb& box, const Point2D& center, double radius) {
+		if (id >= items.size()) {
+			items.resize((size_t)id + 1, Item());
+		}
+		if (items[id].in) {
+			Remove(id);
+		}
+		Item& item = items[id];
+		item.box = box;
+		item.center = center;
+		item.radius = radius;
+		item.order = next_order++;
+		item.x0 = Coordinate(box.min.x);
+		item.y0 = Coordinate(box.min.y);
+		item.x1 = Coordinate(box.max.x);
+		item.y1 = Coordinate(box.max.y);
+		item.in = true;
+		for (int32_t x = item.x0; x <= item.x1; x++) {
+			for (int32_t y = item.y0; y <= item.y1; y++) {
+				cells[Key(x, y)].push_back(id);
+			}
+		}
+		count++;
+	}
+
+	void PickIndex::Move(Id id, const Point2D& center) {
+		Item& item = items[id];
+		double r = item.radius;
+		item.center = center;
+		Relocate(id, Aabb{ Point2D{ center.x - r, center.y - r }, Point2D{ center.x + r, center.y + r } });
+	}
+
+	void PickIndex::Move(Id id, const Aabb& box) {
+		items[id].center = box.min;
+		Relocate(id, box);
+	}
+
+	/* Only the cells the item leaves or enters are touched; while dragging a handle that is nothing at all,
+	most of the time.
+	*/
+	void PickIndex::Relocate(Id id, const Aabb& box) {
+		Item& item = items[id];
+		item.box = box;
+		int32_t x0 = Coordinate(box.min.x);
+		int32_t y0 = Coordinate(box.min.y);
+		int32_t x1 = Coordinate(box.max.x);
+		int32_t y1 = Coordinate(box.max.y);
+		if (x0 == item.x0 && y0 == item.y0 && x1 == item.x1 && y1 == item.y1) {
+			return;
+		}
+
+		for (int32_t x = item.x0; x <= item.x1; x++) {
+			for (int32_t y = item.y0; y <= item.y1; y++) {
+				if (!Inside(x, y, x0, y0, x1, y1)) {
+					auto cell = cells.find(Key(x, y));
+					Erase(cell->second, id);
+					if (cell->second.empty()) {
+						cells.erase(cell);
+					}
+				}
+			}
+		}
+		for (int32_t x = x0; x <= x1; x++) {
+			for (int32_t y = y0; y <= y1; y++) {
+				if (!Inside(x, y, item.x0, item.y0, item.x1, item.y1)) {
+					cells[Key(x, y)].push_back(id);
+				}
+			}
+		}
+		item.x0 = x0;
+		item.y0 = y0;
+		item.x1 = x1;
+		item.y1 = y1;
+	}
+
+	void PickIndex::Remove(Id id) {
+		Item& item = items[id];
+		for (int32_t x = item.x0; x <= item.x1; x++) {
+			for (int32_t y = item.y0; y <= item.y1; y++) {
+				auto cell = cells.find(Key(x, y));
+				Erase(cell->second, id);
+				if (cell->second.empty()) {
+					cells.erase(cell);
+				}
+			}
+		}
+		item.in = false;
+		count--;
+	}
+
+	void PickIndex::Clear() {
+		items.clear();
+		cells.clear();
+		count = 0;
+	}
+
+	// No divisions: the window's ellipses are circles, so this is the distance against the radius, squared.
+	bool PickIndex::Holds(const Item& item, const Point2D& point) const {
+		const Aabb& box = item.box;
+		if (point.x < box.min.x || point.x > box.max.x || point.y < box.min.y || point.y > box.max.y) {
+			return false;
+		}
+		if (item.radius == 0) {
+			return true;
+		}
+		Point2D offset = point - item.center;
+		return Dot(offset, offset) <= item.radius * item.radius;
+	}
+
+	const std::vector<PickIndex::Id>* PickIndex::CellAt(const Point2D& point) const {
+		auto cell = cells.find(Key(Coordinate(point.x), Coordinate(point.y)));
+		return cell == cells.end() ? nullptr : &cell->second;
+	}
+
+	PickIndex::Id PickIndex::Pick(const Point2D& point) const {
+		const std::vector<Id>* cell = CellAt(point);
+		if (cell == nullptr) {
+			return None;
+		}
+		Id best = None;
+		uint64_t best_order = 0;
+		for (Id id : *cell) {
+			const Item& item = items[id];
+			if ((best == None || item.order > best_order) && Holds(item, point)) {
+				best = id;
+				best_order = item.order;
+			}
+		}
+		return best;
+	}
+
+	void PickIndex::PickAll(const Point2D& point, std::vector<Id>& out) const {
+		out.clear();
+		const std::vector<Id>* cell = CellAt(point);
+		if (cell == nullptr) {
+			return;
+		}
+		for (Id id : *cell) {
+			if (Holds(items[id], point)) {
+				out.push_back(id);
+			}
+		}
+		std::sort(out.begin(), out.end(), [this](Id a, Id b) { return items[a].order > items[b].order; });
+	}
+}
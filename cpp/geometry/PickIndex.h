@@ -0,0 +1,88 @@
+#ifndef _GEOMETRY_PICKINDEX_H
+#define _GEOMETRY_PICKINDEX_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "Aabb.h"
+#include "Point2D.h"
+
+namespace Geometry {
+
+	/* What is under the mouse: of many circles (drag handles) and boxes (the bounds of hulls), the topmost
+	one holding a point. Whatever went in last is on top, like the window drawing its list front to back.
+
+	A uniform grid kept up to date as things move, not rebuilt: every item is in each cell its box covers,
+	so a pick looks in the one cell holding the point and tests only what is there. An item that moves
+	without leaving its cells costs nothing but the new position; one that does only leaves and enters the
+	cells that changed. Cells are in a hash map keyed by their grid coordinates, so the grid is unbounded and
+	empty cells cost nothing.
+
+	Ids are picked by the caller and meant to be small (indices, or the slots of handles), the items are
+	kept in an array by id. Best with cells a bit bigger than the handles; a big box (a whole hull) goes
+	into every cell it covers, which is fine for a few of them.
+	*/
+	class PickIndex {
+
+	public:
+		typedef uint32_t Id;
+
+		static const Id None = UINT32_MAX;
+
+		// Twice the 20 unit handles the window draws.
+		static constexpr double DefaultCellSize = 32.0;
+
+		explicit PickIndex(double cell_size = DefaultCellSize);
+
+		// On top of everything already in. A circle holds the points at most radius from its center.
+		void Insert(Id id, const Point2D& center, double radius);
+		void Insert(Id id, const Aabb& box);
+
+		// Keeps the item's place in the stack; a circle keeps its radius.
+		void Move(Id id, const Point2D& center);
+		void Move(Id id, const Aabb& box);
+
+		void Remove(Id id);
+		void Clear();
+
+		bool Has(Id id) const { return id < items.size() && items[id].in; }
+
+		// The topmost item holding point (its edge counts), None if there is none.
+		Id Pick(const Point2D& point) const;
+
+		// Every item holding point, topmost first, for a caller with its own exact test (a hull in its bounds).
+		// Replaces out.
+		void PickAll(const Point2D& point, std::vector<Id>& out) const;
+
+		size_t Size() const { return count; }
+		size_t Cells() const { return cells.size(); }
+
+	private:
+		struct Item {
+			Aabb box;
+			Point2D center;
+			double radius;		// 0 for a box.
+			uint64_t order;		// Higher is on top.
+			int32_t x0, y0, x1, y1;		// Cells covered, inclusive.
+			bool in;
+		};
+
+		double inverse;			// 1 / cell size.
+		std::vector<Item> items;	// By id.
+		std::unordered_map<uint64_t, std::vector<Id>> cells;
+		uint64_t next_order;
+		size_t count;
+
+		int32_t Coordinate(double value) const;
+		static uint64_t Key(int32_t x, int32_t y) { return ((uint64_t)(uint32_t)x << 32) | (uint32_t)y; }
+		bool Holds(const Item& item, const Point2D& point) const;
+		const std::vector<Id>* CellAt(const Point2D& point) const;
+		void Place(Id id, const Aabb& box, const Point2D& center, double radius);
+		void Relocate(Id id, const Aabb& box);
+	};
+}
+
+#endif
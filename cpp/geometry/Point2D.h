@@ -0,0 +1,50 @@
+#ifndef _GEOMETRY_POINT2D_H
+#define _GEOMETRY_POINT2D_H
+#pragma once
+
+// Plain point type for the geometry core. It deliberately knows nothing about
+// Direct2D so the hull and collision code can be built and profiled anywhere;
+// the window code converts D2D1_ELLIPSE handles to and from it (see GeometryAdapter.h).
+
+namespace Geometry {
+
+	struct Point2D {
+		double x;
+		double y;
+	};
+
+	inline bool operator==(const Point2D& a, const Point2D& b) {
+		return a.x == b.x && a.y == b.y;
+	}
+
+	inline bool operator!=(const Point2D& a, const Point2D& b) {
+		return !(a == b);
+	}
+
+	inline Point2D operator+(const Point2D& a, const Point2D& b) {
+		return Point2D{ a.x + b.x, a.y + b.y };
+	}
+
+	inline Point2D operator-(const Point2D& a, const Point2D& b) {
+		return Point2D{ a.x - b.x, a.y - b.y };
+	}
+
+	inline Point2D operator-(const Point2D& a) {
+		return Point2D{ -a.x, -a.y };
+	}
+
+	inline Point2D operator*(double s, const Point2D& a) {
+		return Point2D{ s * a.x, s * a.y };
+	}
+
+	inline double Dot(const Point2D& a, const Point2D& b) {
+		return a.x * b.x + a.y * b.y;
+	}
+
+	// z component of the cross product of (a - o) and (b - o). Positive when o, a, b turn counterclockwise.
+	inline double Cross(const Point2D& o, const Point2D& a, const Point2D& b) {
+		return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+	}
+}
+
+#endif
@@ -0,0 +1,63 @@
+#include "PointStore.h"
+
+namespace Geometry {
+
+	namespace {
+
+		template <typename T>
+		void EraseAt(std::vector<T>& values, size_t index) {
+			values.erase(values.begin() + index);
+		}
+	}
+
+	PointStore::Handle PointStore::Insert(const Point2D& point, double radius, uint32_t color) {
+		uint32_t slot;
+		if (free_slots.empty()) {
+			slot = (uint32_t)slots.size();
+			slots.push_back(Slot{ NoIndex, 0 });
+		}
+		else {
+			slot = free_slots.back();
+			free_slots.pop_back();
+		}
+		// Generations start at 1 and skip 0 when they wrap, so a default Handle never matches.
+		Slot& entry = slots[slot];
+		entry.generation = entry.generation + 1 == 0 ? 1 : entry.generation + 1;
+		entry.index = (uint32_t)xs.size();
+
+		xs.push_back(point.x);
+		ys.push_back(point.y);
+		radii.push_back(radius);
+		colors.push_back(color);
+		owners.push_back(slot);
+		return Handle(slot, entry.generation);
+	}
+
+	// Everything above the point moves down one, and their slots are told.
+	bool PointStore::Remove(Handle handle) {
+		if (!Valid(handle)) {
+			return false;
+		}
+		Slot& entry = slots[handle.slot];
+		size_t index = entry.index;
+		EraseAt(xs, index);
+		EraseAt(ys, index);
+		EraseAt(radii, index);
+		EraseAt(colors, index);
+		EraseAt(owners, index);
+		for (size_t i = index; i < owners.size(); i++) {
+			slots[owners[i]].index = (uint32_t)i;
+		}
+
+		entry.index = NoIndex;
+		free_slots.push_back(handle.slot);
+		return true;
+	}
+
+	// Slots are freed rather than forgotten, so handles from before the Clear stay invalid when they are reused.
+	void PointStore::Clear() {
+		while (!owners.empty()) {
+			Remove(HandleAt(owners.size() - 1));
+		}
+	}
+}
@@ -0,0 +1,90 @@
+#ifndef _GEOMETRY_POINTSTORE_H
+#define _GEOMETRY_POINTSTORE_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace Geometry {
+
+	/* The points an editor shows and drags around (handles: a position, a radius and a color each), kept as
+	structure of arrays. x, y, radii and colors are each one contiguous array, in draw order, so a walk over
+	the points is a walk down an array, and the batch kernels (HullClassifier, HullKernels) take X() and Y()
+	as they are, no copy.
+
+	Points are added on top and keep their order; Remove closes the gap (O(n), but nothing is removed per
+	frame) instead of swapping the last one in, so what was drawn over what stays that way.
+
+	Outside code holds on to a point by a generational handle: a slot that stays with the point while its
+	index moves, and the generation the slot had when the point went in. A slot gets a new generation every
+	time it is reused, so an old handle stops being Valid instead of quietly naming whatever took its slot.
+	A default Handle is never valid. Slots are meant as ids for the caller's own tables (a PickIndex).
+	*/
+	class PointStore {
+
+	public:
+		struct Handle {
+			uint32_t slot;
+			uint32_t generation;	// 0 is never handed out.
+
+			Handle() : slot(0), generation(0) {}
+			Handle(uint32_t slot, uint32_t generation) : slot(slot), generation(generation) {}
+
+			bool operator==(const Handle& other) const { return slot == other.slot && generation == other.generation; }
+			bool operator!=(const Handle& other) const { return !(*this == other); }
+		};
+
+		Handle Insert(const Point2D& point, double radius, uint32_t color);
+
+		// False (and nothing happens) if the handle is stale.
+		bool Remove(Handle handle);
+		void Clear();
+
+		bool Valid(Handle handle) const {
+			return handle.slot < slots.size() && slots[handle.slot].index != NoIndex && slots[handle.slot].generation == handle.generation;
+		}
+
+		// Where a valid handle's point is now, 0 the bottom one, Size() - 1 the top.
+		size_t IndexOf(Handle handle) const { return slots[handle.slot].index; }
+		Handle HandleAt(size_t index) const { return Handle(owners[index], slots[owners[index]].generation); }
+
+		// The live handle in a slot (as a PickIndex id comes back); not valid if the slot is free.
+		Handle AtSlot(uint32_t slot) const { return Handle(slot, slots[slot].generation); }
+
+		size_t Size() const { return xs.size(); }
+
+		Point2D Position(size_t index) const { return Point2D{ xs[index], ys[index] }; }
+		void SetPosition(size_t index, const Point2D& point) {
+			xs[index] = point.x;
+			ys[index] = point.y;
+		}
+
+		// Index order, Size() of each.
+		const double* X() const { return xs.data(); }
+		const double* Y() const { return ys.data(); }
+		const double* Radii() const { return radii.data(); }
+		const uint32_t* Colors() const { return colors.data(); }
+
+	private:
+		static const uint32_t NoIndex = UINT32_MAX;
+
+		struct Slot {
+			uint32_t index;			// NoIndex while free.
+			uint32_t generation;
+		};
+
+		std::vector<double> xs;
+		std::vector<double> ys;
+		std::vector<double> radii;
+		std::vector<uint32_t> colors;
+		std::vector<uint32_t> owners;		// By index: the slot.
+
+		std::vector<Slot> slots;
+		std::vector<uint32_t> free_slots;
+	};
+}
+
+#endif
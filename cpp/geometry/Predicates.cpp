@@ -0,0 +1,434 @@
+#include "Predicates.h"
+
+#include <atomic>
+#include <cmath>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace Geometry {
+
+	namespace {
+
+		// Half an ulp of 1: the relative rounding error of one double operation.
+		const double Epsilon = 1.0 / 9007199254740992.0;
+
+		// 2^27 + 1, for Dekker's split of a double into two 26-bit halves.
+		const double Splitter = 134217729.0;
+
+		const double ResultErrorBound = (3.0 + 8.0 * Epsilon) * Epsilon;
+		const double OrientBoundB = (2.0 + 12.0 * Epsilon) * Epsilon;
+		const double OrientBoundC = (9.0 + 64.0 * Epsilon) * Epsilon * Epsilon;
+
+		// The crossing test rounds at most five times along any path (see CompareCrossing); 8 leaves room for the
+		// rounding of the bound itself.
+		const double CrossingBound = 8.0 * Epsilon;
+
+		/* Error-free transformations: each returns the rounded result in x and the exact rounding error in y,
+		so that x + y is exactly the true result. All of them rely on plain IEEE double arithmetic, without
+		extended precision or contraction into FMA.
+		*/
+		inline void FastTwoSum(double a, double b, double& x, double& y) {
+			x = a + b;
+			double b_virtual = x - a;
+			y = b - b_virtual;
+		}
+
+		inline void TwoSum(double a, double b, double& x, double& y) {
+			x = a + b;
+			double b_virtual = x - a;
+			double a_virtual = x - b_virtual;
+			y = (a - a_virtual) + (b - b_virtual);
+		}
+
+		inline void TwoDiffTail(double a, double b, double x, double& y) {
+			double b_virtual = a - x;
+			double a_virtual = x + b_virtual;
+			y = (a - a_virtual) + (b_virtual - b);
+		}
+
+		inline void TwoDiff(double a, double b, double& x, double& y) {
+			x = a - b;
+			TwoDiffTail(a, b, x, y);
+		}
+
+		inline void Split(double a, double& hi, double& lo) {
+			double c = Splitter * a;
+			double big = c - a;
+			hi = c - big;
+			lo = a - hi;
+		}
+
+		inline void TwoProduct(double a, double b, double& x, double& y) {
+			x = a * b;
+			double a_hi, a_lo, b_hi, b_lo;
+			Split(a, a_hi, a_lo);
+			Split(b, b_hi, b_lo);
+			double err = x - a_hi * b_hi;
+			err -= a_lo * b_hi;
+			err -= a_hi * b_lo;
+			y = a_lo * b_lo - err;
+		}
+
+		// (a1 + a0) - (b1 + b0) as a four-term expansion, smallest term first.
+		inline void TwoTwoDiff(double a1, double a0, double b1, double b0, double* x) {
+			double i, j, k;
+			TwoDiff(a0, b0, i, x[0]);
+			TwoSum(a1, i, j, k);
+			double l;
+			TwoDiff(k, b1, l, x[1]);
+			TwoSum(j, l, x[3], x[2]);
+		}
+
+		/* Sum of two nonoverlapping expansions (smallest term first), zeros dropped. Returns the length of h,
+		at most e_length + f_length.
+		*/
+		size_t ExpansionSum(size_t e_length, const double* e, size_t f_length, const double* f, double* h) {
+			size_t ei = 0, fi = 0, hi = 0;
+			double q;
+			if ((f[0] > e[0]) == (f[0] > -e[0])) {
+				q = e[ei++];
+			}
+			else {
+				q = f[fi++];
+			}
+			double sum, tail;
+			while (ei < e_length && fi < f_length) {
+				if ((f[fi] > e[ei]) == (f[fi] > -e[ei])) {
+					TwoSum(q, e[ei++], sum, tail);
+				}
+				else {
+					TwoSum(q, f[fi++], sum, tail);
+				}
+				q = sum;
+				if (tail != 0) {
+					h[hi++] = tail;
+				}
+			}
+			while (ei < e_length) {
+				TwoSum(q, e[ei++], sum, tail);
+				q = sum;
+				if (tail != 0) {
+					h[hi++] = tail;
+				}
+			}
+			while (fi < f_length) {
+				TwoSum(q, f[fi++], sum, tail);
+				q = sum;
+				if (tail != 0) {
+					h[hi++] = tail;
+				}
+			}
+			if (q != 0 || hi == 0) {
+				h[hi++] = q;
+			}
+			return hi;
+		}
+
+		// e times b, zeros dropped. Returns the length of h, at most 2 * e_length.
+		size_t ScaleExpansion(size_t e_length, const double* e, double b, double* h) {
+			size_t hi = 0;
+			double q, tail;
+			TwoProduct(e[0], b, q, tail);
+			if (tail != 0) {
+				h[hi++] = tail;
+			}
+			for (size_t i = 1; i < e_length; i++) {
+				double product, product_tail, sum;
+				TwoProduct(e[i], b, product, product_tail);
+				TwoSum(q, product_tail, sum, tail);
+				if (tail != 0) {
+					h[hi++] = tail;
+				}
+				FastTwoSum(product, sum, q, tail);
+				if (tail != 0) {
+					h[hi++] = tail;
+				}
+			}
+			if (q != 0 || hi == 0) {
+				h[hi++] = q;
+			}
+			return hi;
+		}
+
+		// The largest term of a nonoverlapping expansion carries its sign.
+		inline int Sign(double value) {
+			return value > 0 ? 1 : (value < 0 ? -1 : 0);
+		}
+
+		// p x q of the position vectors, exactly, as four terms.
+		inline void PerpDot(const Point2D& p, const Point2D& q, double* x) {
+			double l1, l0, r1, r0;
+			TwoProduct(p.x, q.y, l1, l0);
+			TwoProduct(p.y, q.x, r1, r0);
+			TwoTwoDiff(l1, l0, r1, r0, x);
+		}
+
+		// (a - b) x (c - d) = a x c - a x d - b x c + b x d, exactly. h needs room for 16 terms.
+		size_t CrossExpansion(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d, double* h) {
+			double ac[4], ad[4], bc[4], bd[4];
+			PerpDot(a, c, ac);
+			PerpDot(a, d, ad);
+			PerpDot(b, c, bc);
+			PerpDot(b, d, bd);
+			for (int i = 0; i < 4; i++) {
+				ad[i] = -ad[i];
+				bc[i] = -bc[i];
+			}
+			double left[8], right[8];
+			size_t left_length = ExpansionSum(4, ac, 4, ad, left);
+			size_t right_length = ExpansionSum(4, bd, 4, bc, right);
+			return ExpansionSum(left_length, left, right_length, right, h);
+		}
+
+		// e * (b1 + b0), exactly. h needs room for 4 * e_length terms.
+		size_t ScaleByTwo(size_t e_length, const double* e, double b1, double b0, double* h) {
+			double high[32], low[32];
+			size_t high_length = ScaleExpansion(e_length, e, b1, high);
+			if (b0 == 0) {
+				for (size_t i = 0; i < high_length; i++) {
+					h[i] = high[i];
+				}
+				return high_length;
+			}
+			size_t low_length = ScaleExpansion(e_length, e, b0, low);
+			return ExpansionSum(high_length, high, low_length, low, h);
+		}
+
+		/* Shewchuk's orient2dadapt: the determinant (a - c) x (b - c) in stages of growing precision, each with
+		its own error bound, until one of them is sure of the sign.
+		*/
+		double OrientAdaptive(const Point2D& a, const Point2D& b, const Point2D& c, double sum) {
+			double acx = a.x - c.x;
+			double bcx = b.x - c.x;
+			double acy = a.y - c.y;
+			double bcy = b.y - c.y;
+
+			double left, left_tail, right, right_tail;
+			TwoProduct(acx, bcy, left, left_tail);
+			TwoProduct(acy, bcx, right, right_tail);
+			double B[4];
+			TwoTwoDiff(left, left_tail, right, right_tail, B);
+
+			double det = B[0] + B[1] + B[2] + B[3];
+			double bound = OrientBoundB * sum;
+			if (det >= bound || -det >= bound) {
+				return det;
+			}
+
+			double acx_tail, bcx_tail, acy_tail, bcy_tail;
+			TwoDiffTail(a.x, c.x, acx, acx_tail);
+			TwoDiffTail(b.x, c.x, bcx, bcx_tail);
+			TwoDiffTail(a.y, c.y, acy, acy_tail);
+			TwoDiffTail(b.y, c.y, bcy, bcy_tail);
+			if (acx_tail == 0 && acy_tail == 0 && bcx_tail == 0 && bcy_tail == 0) {
+				return det;
+			}
+
+			bound = OrientBoundC * sum + ResultErrorBound * std::fabs(det);
+			det += (acx * bcy_tail + bcy * acx_tail) - (acy * bcx_tail + bcx * acy_tail);
+			if (det >= bound || -det >= bound) {
+				return det;
+			}
+
+			double s1, s0, t1, t0, u[4];
+			double C1[8], C2[12], D[16];
+			TwoProduct(acx_tail, bcy, s1, s0);
+			TwoProduct(acy_tail, bcx, t1, t0);
+			TwoTwoDiff(s1, s0, t1, t0, u);
+			size_t c1_length = ExpansionSum(4, B, 4, u, C1);
+
+			TwoProduct(acx, bcy_tail, s1, s0);
+			TwoProduct(acy, bcx_tail, t1, t0);
+			TwoTwoDiff(s1, s0, t1, t0, u);
+			size_t c2_length = ExpansionSum(c1_length, C1, 4, u, C2);
+
+			TwoProduct(acx_tail, bcy_tail, s1, s0);
+			TwoProduct(acy_tail, bcx_tail, t1, t0);
+			TwoTwoDiff(s1, s0, t1, t0, u);
+			size_t d_length = ExpansionSum(c2_length, C2, 4, u, D);
+			return D[d_length - 1];
+		}
+
+		/* Counters. Each thread gets its own block the first time it counts anything. Only the owner writes a
+		block, so a relaxed load and store is enough (no locked add); readers may see a count a moment late.
+		Blocks outlive their threads so that Totals() still includes them.
+		*/
+		enum Counter {
+			OrientCalls,
+			OrientExactCalls,
+			CrossCalls,
+			CrossExactCalls,
+			CrossingCalls,
+			CrossingExactCalls,
+			CounterCount
+		};
+
+		struct Block {
+			std::atomic<uint64_t> values[CounterCount];
+
+			Block() {
+				for (auto& value : values) {
+					value.store(0, std::memory_order_relaxed);
+				}
+			}
+		};
+
+		struct Registry {
+			std::mutex lock;
+			std::vector<std::unique_ptr<Block>> blocks;
+		};
+
+		// Never destroyed: threads may still count while static destructors run.
+		Registry& Blocks() {
+			static Registry* registry = new Registry();
+			return *registry;
+		}
+
+		Block* NewBlock() {
+			Registry& registry = Blocks();
+			std::lock_guard<std::mutex> hold(registry.lock);
+			registry.blocks.emplace_back(new Block());
+			return registry.blocks.back().get();
+		}
+
+		// Constant initialized, so no TLS init guard on the way in.
+		thread_local Block* local_block = nullptr;
+
+		inline void Count(Counter counter) {
+			if (local_block == nullptr) {
+				local_block = NewBlock();
+			}
+			std::atomic<uint64_t>& value = local_block->values[counter];
+			value.store(value.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+		}
+	}
+
+	std::atomic<bool> Predicates::counting_calls(false);
+
+	void Predicates::CountOrient() {
+		Count(OrientCalls);
+	}
+
+	void Predicates::CountCross() {
+		Count(CrossCalls);
+	}
+
+	// The inline filter could not decide; only products of the same sign (or both zero) get here.
+	int Predicates::OrientExact(const Point2D& o, const Point2D& a, const Point2D& b) {
+		double left = (o.x - b.x) * (a.y - b.y);
+		double right = (o.y - b.y) * (a.x - b.x);
+		if (left == 0 && right == 0) {
+			return 0;
+		}
+		Count(OrientExactCalls);
+		return Sign(OrientAdaptive(o, a, b, std::fabs(left) + std::fabs(right)));
+	}
+
+	int Predicates::CrossExact(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d) {
+		Count(CrossExactCalls);
+		double h[16];
+		size_t length = CrossExpansion(a, b, c, d, h);
+		return Sign(h[length - 1]);
+	}
+
+	/* The crossing is a + t (b - a) with t = d1 / D, where d1 = (d - c) x (a - c) and D = (d - c) x (a - b).
+	So for either coordinate, crossing - point has the sign of N * D with
+
+		N = (a - point) * D + d1 * (b - a)
+
+	a degree three polynomial in the input. In doubles N is at most five roundings deep (difference, product,
+	difference for D and d1, then product and sum), which gives the filter bound on the sum of the absolute
+	values of its terms. Past the filter N and D are formed again as expansions.
+	*/
+	int Predicates::CompareCrossing(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d, const Point2D& point) {
+		Count(CrossingCalls);
+		double lx = d.x - c.x;
+		double ly = d.y - c.y;
+		double denominator_left = lx * (a.y - b.y);
+		double denominator_right = ly * (a.x - b.x);
+		double denominator = denominator_left - denominator_right;
+		double denominator_sum = std::fabs(denominator_left) + std::fabs(denominator_right);
+
+		if (denominator >= OrientErrorBound * denominator_sum || -denominator >= OrientErrorBound * denominator_sum) {
+			double from_a_left = lx * (a.y - c.y);
+			double from_a_right = ly * (a.x - c.x);
+			double from_a = from_a_left - from_a_right;
+			double from_a_sum = std::fabs(from_a_left) + std::fabs(from_a_right);
+
+			bool settled = true;
+			for (int axis = 0; axis < 2 && settled; axis++) {
+				double to_point = axis == 0 ? a.x - point.x : a.y - point.y;
+				double along = axis == 0 ? b.x - a.x : b.y - a.y;
+				double numerator = to_point * denominator + from_a * along;
+				double numerator_sum = std::fabs(to_point) * denominator_sum + from_a_sum * std::fabs(along);
+				if (numerator_sum == 0) {
+					continue;
+				}
+				double bound = CrossingBound * numerator_sum;
+				if (numerator > bound || -numerator > bound) {
+					return Sign(numerator) * Sign(denominator);
+				}
+				settled = false;
+			}
+			if (settled) {
+				return 0;
+			}
+		}
+
+		Count(CrossingExactCalls);
+		double denominator_terms[16], from_a_terms[16];
+		size_t denominator_length = CrossExpansion(d, c, a, b, denominator_terms);
+		size_t from_a_length = CrossExpansion(d, c, a, c, from_a_terms);
+		int denominator_sign = Sign(denominator_terms[denominator_length - 1]);
+
+		for (int axis = 0; axis < 2; axis++) {
+			double to_point1, to_point0, along1, along0;
+			if (axis == 0) {
+				TwoDiff(a.x, point.x, to_point1, to_point0);
+				TwoDiff(b.x, a.x, along1, along0);
+			}
+			else {
+				TwoDiff(a.y, point.y, to_point1, to_point0);
+				TwoDiff(b.y, a.y, along1, along0);
+			}
+
+			double first[64], second[64], numerator[128];
+			size_t first_length = ScaleByTwo(denominator_length, denominator_terms, to_point1, to_point0, first);
+			size_t second_length = ScaleByTwo(from_a_length, from_a_terms, along1, along0, second);
+			size_t length = ExpansionSum(first_length, first, second_length, second, numerator);
+			int sign = Sign(numerator[length - 1]);
+			if (sign != 0) {
+				return sign * denominator_sign;
+			}
+		}
+		return 0;
+	}
+
+	Predicates::Stats Predicates::Totals() {
+		uint64_t sums[CounterCount] = {};
+		Registry& registry = Blocks();
+		std::lock_guard<std::mutex> hold(registry.lock);
+		for (const auto& block : registry.blocks) {
+			for (int i = 0; i < CounterCount; i++) {
+				sums[i] += block->values[i].load(std::memory_order_relaxed);
+			}
+		}
+		return Stats{ sums[OrientCalls], sums[OrientExactCalls], sums[CrossCalls], sums[CrossExactCalls], sums[CrossingCalls], sums[CrossingExactCalls] };
+	}
+
+	void Predicates::CountCalls(bool on) {
+		counting_calls.store(on, std::memory_order_relaxed);
+	}
+
+	// Counts made by other threads while this runs may survive the reset.
+	void Predicates::ResetTotals() {
+		Registry& registry = Blocks();
+		std::lock_guard<std::mutex> hold(registry.lock);
+		for (const auto& block : registry.blocks) {
+			for (auto& value : block->values) {
+				value.store(0, std::memory_order_relaxed);
+			}
+		}
+	}
+}
@@ -0,0 +1,119 @@
+#ifndef _GEOMETRY_PREDICATES_H
+#define _GEOMETRY_PREDICATES_H
+#pragma once
+
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+
+#include "Point2D.h"
+
+namespace Geometry {
+
+	/* Exact geometric predicates, after Shewchuk's "Adaptive Precision Floating-Point Arithmetic and Fast
+	Robust Geometric Predicates".
+
+	Each predicate first evaluates the plain double expression together with a bound on its rounding error.
+	Nearly always the result is farther from zero than the bound and its sign is final; that part is inline,
+	it sits in every hull loop. Only when it is not (nearly collinear input) does the predicate redo the
+	computation with floating-point expansions, which are exact. Orient2D also has Shewchuk's intermediate
+	adaptive stages, so the exact path usually stops early.
+
+	The signs are exact for any double input, as long as nothing overflows or underflows.
+
+	The SIMD kernels use the same filter per lane (OrientErrorBound) and only call back in here for lanes
+	where it is inconclusive.
+	*/
+	class Predicates {
+
+	public:
+		// Relative error bound of the double evaluation of (a - c) x (b - c), Shewchuk's ccwerrboundA:
+		// the sign is certain when |det| > OrientErrorBound * (|left product| + |right product|).
+		static constexpr double OrientErrorBound = (3.0 + 16.0 / 9007199254740992.0) / 9007199254740992.0;
+
+		// Sign of Cross(o, a, b): 1 if o, a, b turn counterclockwise, -1 if clockwise, 0 if collinear.
+		static int Orient2D(const Point2D& o, const Point2D& a, const Point2D& b);
+
+		// Sign of the cross product (a - b) x (c - d).
+		static int CrossSign(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d);
+
+		// Sign of the dot product (a - b) . (c - d).
+		static int DotSign(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d);
+
+		/* Where the line through a and b crosses the line through c and d, compared to point in x-then-y order:
+		-1 if the crossing comes first, 1 if it comes after, 0 if it is point. The lines must not be parallel.
+		*/
+		static int CompareCrossing(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d, const Point2D& point);
+
+		/* How often the predicates ran and how often the filter was not enough. Every thread counts into its own
+		block (no shared cache lines in the hot loops); Totals() adds up the blocks of all threads that ever ran one.
+
+		The exact paths are always counted. Counting every call of Orient2D and CrossSign would cost the hull
+		loops a few percent, so orient and cross stay 0 unless CountCalls(true) is on.
+		*/
+		struct Stats {
+			uint64_t orient;
+			uint64_t orient_exact;
+			uint64_t cross;
+			uint64_t cross_exact;
+			uint64_t crossing;
+			uint64_t crossing_exact;
+		};
+
+		static Stats Totals();
+		static void ResetTotals();
+		static void CountCalls(bool on);
+
+	private:
+		static std::atomic<bool> counting_calls;
+
+		static void CountOrient();
+		static void CountCross();
+		static int OrientExact(const Point2D& o, const Point2D& a, const Point2D& b);
+		static int CrossExact(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d);
+	};
+
+	/* The filter. If the two products have different signs (or one is zero) nothing cancels and |det| is their
+	whole sum, far above the bound; both zero is the one case that goes through to OrientExact with det = 0.
+	*/
+	inline int Predicates::Orient2D(const Point2D& o, const Point2D& a, const Point2D& b) {
+		if (counting_calls.load(std::memory_order_relaxed)) {
+			CountOrient();
+		}
+		double left = (o.x - b.x) * (a.y - b.y);
+		double right = (o.y - b.y) * (a.x - b.x);
+		double det = left - right;
+		double bound = OrientErrorBound * (std::fabs(left) + std::fabs(right));
+		if (det > bound) {
+			return 1;
+		}
+		if (-det > bound) {
+			return -1;
+		}
+		return OrientExact(o, a, b);
+	}
+
+	inline int Predicates::CrossSign(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d) {
+		if (counting_calls.load(std::memory_order_relaxed)) {
+			CountCross();
+		}
+		double left = (a.x - b.x) * (c.y - d.y);
+		double right = (a.y - b.y) * (c.x - d.x);
+		double det = left - right;
+		double bound = OrientErrorBound * (std::fabs(left) + std::fabs(right));
+		if (det > bound) {
+			return 1;
+		}
+		if (-det > bound) {
+			return -1;
+		}
+		return CrossExact(a, b, c, d);
+	}
+
+	// u . v is u x (v turned a quarter to the left), and turning c and d separately is exact.
+	inline int Predicates::DotSign(const Point2D& a, const Point2D& b, const Point2D& c, const Point2D& d) {
+		return CrossSign(a, b, Point2D{ -c.y, c.x }, Point2D{ -d.y, d.x });
+	}
+}
+
+#endif
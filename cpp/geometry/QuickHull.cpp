@@ -0,0 +1,199 @@
+#include "QuickHull.h"
+
+#include <algorithm>
+
+#include "AklToussaint.h"
+#include "HullKernels.h"
+#include "MonotoneChain.h"
+#include "Predicates.h"
+#include "TaskPool.h"
+
+namespace Geometry {
+
+	QuickHull::QuickHull(const std::vector<Point2D>& orig_list) : points(orig_list), prefilter(false), culled(0) {
+	}
+
+	namespace {
+		/* Two-pointer partition of the parallel arrays x / y over [begin, end): points for which keep() holds
+		end up first. Returns where the others start. Like std::partition, the order within each side is not kept.
+		*/
+		template <typename Keep>
+		size_t PartitionSoA(double* x, double* y, size_t begin, size_t end, Keep keep) {
+			size_t lo = begin;
+			size_t hi = end;
+			while (true) {
+				while (lo < hi && keep(Point2D{ x[lo], y[lo] })) {
+					lo++;
+				}
+				while (lo < hi && !keep(Point2D{ x[hi - 1], y[hi - 1] })) {
+					hi--;
+				}
+				if (lo == hi) {
+					return lo;
+				}
+				hi--;
+				std::swap(x[lo], x[hi]);
+				std::swap(y[lo], y[hi]);
+				lo++;
+			}
+		}
+
+		/* The partitions are exact, so every hull vertex makes it into the output. The farthest-point scan is
+		not: of two points within rounding of the same distance it may pick the one a hair inside the hull.
+		Such a point shows up as a vertex without a left turn; if there is one, the (short) output goes through
+		MonotoneChain once more.
+		*/
+		void MakeConvex(std::vector<Point2D>& hull) {
+			const size_t h = hull.size();
+			if (h < 3) {
+				return;
+			}
+			for (size_t i = 0; i < h; i++) {
+				if (Predicates::Orient2D(hull[i], hull[(i + 1) % h], hull[(i + 2) % h]) <= 0) {
+					std::vector<Point2D> sorted(hull);
+					hull.resize(h + 1);
+					hull.resize(MonotoneChain::GetConvexHull(sorted.data(), h, hull.data()));
+					return;
+				}
+			}
+		}
+	}
+
+	/* xs / ys [begin, end) hold the points strictly to the right of p1 -> p2, i.e. outside the hull edge.
+	Finds the farthest of them (c) and partitions the range into [begin, split) outside p1 -> c and
+	[split, outside) outside c -> p2. Nothing can be outside both, and the rest is inside the triangle.
+	*/
+	void QuickHull::Split(size_t begin, size_t end, const Point2D& p1, const Point2D& p2, Point2D& c, size_t& split, size_t& outside) {
+		// The scan is the vectorized part. It breaks ties towards p1 along the edge: of several points on the same
+		// parallel line only the two ends are hull vertices, and picking one from the middle would leave it in the output.
+		HullKernels::EdgeScan scan = HullKernels::ScanEdge(xs.data() + begin, ys.data() + begin, end - begin, p1, p2);
+		size_t farthest = begin + scan.farthest;
+		c = Point2D{ xs[farthest], ys[farthest] };
+
+		split = PartitionSoA(xs.data(), ys.data(), begin, end, [&](const Point2D& p) { return Predicates::Orient2D(p1, c, p) < 0; });
+		outside = PartitionSoA(xs.data(), ys.data(), split, end, [&](const Point2D& p) { return Predicates::Orient2D(c, p2, p) < 0; });
+	}
+
+	// Emits the hull vertices strictly between p1 and p2 in order.
+	void QuickHull::Quick(size_t begin, size_t end, const Point2D& p1, const Point2D& p2, std::vector<Point2D>& out) {
+		if (begin == end) {
+			return;
+		}
+
+		Point2D c;
+		size_t split, outside;
+		Split(begin, end, p1, p2, c, split, outside);
+
+		Quick(begin, split, p1, c, out);
+		out.push_back(c);
+		Quick(split, outside, c, p2, out);
+	}
+
+	void QuickHull::QuickParallel(TaskPool& pool, size_t cutoff, size_t begin, size_t end, const Point2D& p1, const Point2D& p2, std::vector<Point2D>& out) {
+		if (end - begin < cutoff) {
+			Quick(begin, end, p1, p2, out);
+			return;
+		}
+
+		Point2D c;
+		size_t split, outside;
+		Split(begin, end, p1, p2, c, split, outside);
+
+		std::vector<Point2D> right;
+		TaskGroup group(pool);
+		group.Run([&, c, split, outside]() { QuickParallel(pool, cutoff, split, outside, c, p2, right); });
+		QuickParallel(pool, cutoff, begin, split, p1, c, out);
+		out.push_back(c);
+		group.Wait();
+		out.insert(out.end(), right.begin(), right.end());
+	}
+
+	/* Picks the lowest-x and highest-x points (a and b), copies the points into xs / ys and partitions them into the points below
+	a -> b (the lower chain) followed by the ones above it; points on the line are never hull vertices.
+	Returns false if every point is the same.
+	*/
+	bool QuickHull::Setup(Point2D& a, Point2D& b, size_t& below, size_t& above) {
+		culled = 0;
+		size_t min_x = 0;
+		size_t max_x = 0;
+
+		for (size_t i = 1; i < points.size(); i++) {
+			const Point2D& p = points[i];
+			if (p.x < points[min_x].x || (p.x == points[min_x].x && p.y < points[min_x].y)) {
+				min_x = i;
+			}
+			if (p.x > points[max_x].x || (p.x == points[max_x].x && p.y > points[max_x].y)) {
+				max_x = i;
+			}
+		}
+
+		a = points[min_x];
+		b = points[max_x];
+		if (a == b) {
+			return false;
+		}
+
+		xs.resize(points.size());
+		ys.resize(points.size());
+		for (size_t i = 0; i < points.size(); i++) {
+			xs[i] = points[i].x;
+			ys[i] = points[i].y;
+		}
+		// a and b have the lowest and highest x, so they cannot be strictly inside the octagon and always survive.
+		size_t n = points.size();
+		if (prefilter) {
+			n = AklToussaint::Filter(xs.data(), ys.data(), n);
+			culled = points.size() - n;
+		}
+
+		below = PartitionSoA(xs.data(), ys.data(), 0, n, [&](const Point2D& p) { return Predicates::Orient2D(a, b, p) < 0; });
+		above = PartitionSoA(xs.data(), ys.data(), below, n, [&](const Point2D& p) { return Predicates::Orient2D(a, b, p) > 0; });
+		return true;
+	}
+
+	std::vector<Point2D> QuickHull::GetConvexHull() {
+		hull.clear();
+		if (points.empty()) {
+			return hull;
+		}
+
+		Point2D a, b;
+		size_t below, above;
+		bool spread = Setup(a, b, below, above);
+		hull.push_back(a);
+		if (!spread) {
+			return hull;
+		}
+
+		Quick(0, below, a, b, hull);
+		hull.push_back(b);
+		Quick(below, above, b, a, hull);
+		MakeConvex(hull);
+		return hull;
+	}
+
+	std::vector<Point2D> QuickHull::GetConvexHull(TaskPool& pool, size_t cutoff) {
+		hull.clear();
+		if (points.empty()) {
+			return hull;
+		}
+
+		Point2D a, b;
+		size_t below, above;
+		bool spread = Setup(a, b, below, above);
+		hull.push_back(a);
+		if (!spread) {
+			return hull;
+		}
+
+		std::vector<Point2D> upper;
+		TaskGroup group(pool);
+		group.Run([&]() { QuickParallel(pool, cutoff, below, above, b, a, upper); });
+		QuickParallel(pool, cutoff, 0, below, a, b, hull);
+		hull.push_back(b);
+		group.Wait();
+		hull.insert(hull.end(), upper.begin(), upper.end());
+		MakeConvex(hull);
+		return hull;
+	}
+}
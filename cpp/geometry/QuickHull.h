@@ -0,0 +1,56 @@
+#ifndef _GEOMETRY_QUICKHULL_H
+#define _GEOMETRY_QUICKHULL_H
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace Geometry {
+
+	class TaskPool;
+
+	/* QuickHull over one structure-of-arrays copy of the points (xs / ys). Each step finds the point farthest
+	outside the current edge and partitions the edge's range in place so that the points outside the two new
+	edges sit in two contiguous sub-ranges; everything else is dropped. No copies are made while recursing.
+	The farthest-point search runs on the SIMD kernel in HullKernels, which wants the coordinates contiguous.
+
+	The result has the same contract as MonotoneChain: counterclockwise (y up), starting at the lowest-x
+	point, no collinear points or duplicates.
+	*/
+	class QuickHull {
+
+	public:
+		// Sub-problems smaller than this are not worth a task of their own.
+		static const size_t DefaultParallelCutoff = 16384;
+
+		std::vector<Point2D> points;
+		std::vector<Point2D> hull;
+
+		// Run the Akl–Toussaint octagon filter before recursing. Off by default; culled says how many points it dropped.
+		bool prefilter;
+		size_t culled;
+
+		QuickHull(const std::vector<Point2D>& orig_list);
+
+		std::vector<Point2D> GetConvexHull();
+
+		/* Same hull, but the two chains and every sub-problem with at least `cutoff` points run as tasks on the pool.
+		Sub-ranges are disjoint, so tasks only share the read-only points; each one returns its vertices in a
+		vector of its own and the parent splices them in order, so the output matches the serial engine exactly.
+		*/
+		std::vector<Point2D> GetConvexHull(TaskPool& pool, size_t cutoff = DefaultParallelCutoff);
+
+	private:
+		std::vector<double> xs;
+		std::vector<double> ys;
+
+		bool Setup(Point2D& a, Point2D& b, size_t& below, size_t& above);
+		void Split(size_t begin, size_t end, const Point2D& p1, const Point2D& p2, Point2D& c, size_t& split, size_t& outside);
+		void Quick(size_t begin, size_t end, const Point2D& p1, const Point2D& p2, std::vector<Point2D>& out);
+		void QuickParallel(TaskPool& pool, size_t cutoff, size_t begin, size_t end, const Point2D& p1, const Point2D& p2, std::vector<Point2D>& out);
+	};
+}
+
+#endif
@@ -0,0 +1,153 @@
+#include "SpatialHash.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Geometry {
+
+	namespace {
+
+		const size_t NoSlot = (size_t)-1;
+
+		// Slots in the table for every entry at least; with several boxes to a cell, the table stays well under half full.
+		const size_t TableSlack = 2;
+		const size_t MinTable = 64;
+
+		uint32_t Hash(int32_t x, int32_t y) {
+			uint64_t key = ((uint64_t)(uint32_t)x << 32) | (uint32_t)y;
+			return (uint32_t)((key * 0x9E3779B97F4A7C15ull) >> 32);
+		}
+	}
+
+	SpatialHash::SpatialHash(double cell_size) : inverse(1.0 / cell_size), occupied(0), built(false) {}
+
+	void SpatialHash::Add(Id id, const Aabb& box) {
+		if (id >= slots.size()) {
+			slots.resize((size_t)id + 1, NoSlot);
+		}
+		slots[id] = boxes.size();
+		boxes.push_back(box);
+		ids.push_back(id);
+		built = false;
+	}
+
+	void SpatialHash::Move(Id id, const Aabb& box) {
+		boxes[slots[id]] = box;
+		built = false;
+	}
+
+	void SpatialHash::Remove(Id id) {
+		size_t slot = slots[id];
+		boxes[slot] = boxes.back();
+		ids[slot] = ids.back();
+		slots[ids[slot]] = slot;
+		boxes.pop_back();
+		ids.pop_back();
+		slots[id] = NoSlot;
+		built = false;
+	}
+
+	int32_t SpatialHash::Coordinate(double value) const {
+		return (int32_t)std::floor(value * inverse);
+	}
+
+	// The cell's slot, claimed if it was not in the table yet. The table always has empty slots left.
+	uint32_t SpatialHash::Find(int32_t x, int32_t y) {
+		uint32_t mask = (uint32_t)table.size() - 1;
+		uint32_t slot = Hash(x, y) & mask;
+		while (true) {
+			Cell& cell = table[slot];
+			if (cell.count == 0) {
+				cell.x = x;
+				cell.y = y;
+				occupied++;
+				return slot;
+			}
+			if (cell.x == x && cell.y == y) {
+				return slot;
+			}
+			slot = (slot + 1) & mask;
+		}
+	}
+
+	/* Two passes over the boxes' cells in the same order. The first finds each cell's slot (remembered per
+	entry in entry_cells) and counts; the counts turn into starts; the second drops each box into its place.
+	*/
+	void SpatialHash::Build() {
+		size_t total = 0;
+		for (const Aabb& box : boxes) {
+			total += (size_t)(Coordinate(box.max.x) - Coordinate(box.min.x) + 1) * (size_t)(Coordinate(box.max.y) - Coordinate(box.min.y) + 1);
+		}
+		size_t size = MinTable;
+		while (size < total * TableSlack) {
+			size *= 2;
+		}
+		table.assign(size, Cell{ 0, 0, 0, 0 });
+		entry_cells.resize(total);
+		occupied = 0;
+
+		size_t k = 0;
+		for (const Aabb& box : boxes) {
+			int32_t x0 = Coordinate(box.min.x);
+			int32_t x1 = Coordinate(box.max.x);
+			int32_t y0 = Coordinate(box.min.y);
+			int32_t y1 = Coordinate(box.max.y);
+			for (int32_t y = y0; y <= y1; y++) {
+				for (int32_t x = x0; x <= x1; x++) {
+					uint32_t slot = Find(x, y);
+					table[slot].count++;
+					entry_cells[k++] = slot;
+				}
+			}
+		}
+
+		uint32_t start = 0;
+		for (Cell& cell : table) {
+			cell.start = start;
+			start += cell.count;
+			cell.count = 0;
+		}
+
+		entries.resize(total);
+		k = 0;
+		for (uint32_t i = 0; i < boxes.size(); i++) {
+			const Aabb& box = boxes[i];
+			size_t cells = (size_t)(Coordinate(box.max.x) - Coordinate(box.min.x) + 1) * (size_t)(Coordinate(box.max.y) - Coordinate(box.min.y) + 1);
+			for (size_t c = 0; c < cells; c++) {
+				Cell& cell = table[entry_cells[k++]];
+				entries[cell.start + cell.count++] = i;
+			}
+		}
+		built = true;
+	}
+
+	void SpatialHash::FindPairs(std::vector<Pair>& out) {
+		if (!built) {
+			Build();
+		}
+		out.clear();
+		uint64_t tests = 0;
+		for (const Cell& cell : table) {
+			const uint32_t* in_cell = entries.data() + cell.start;
+			for (uint32_t a = 1; a < cell.count; a++) {
+				const Aabb& first = boxes[in_cell[a]];
+				for (uint32_t b = 0; b < a; b++) {
+					const Aabb& second = boxes[in_cell[b]];
+					tests++;
+					if (!Overlaps(first, second)) {
+						continue;
+					}
+					// Only from the cell the overlap starts in.
+					if (Coordinate(std::max(first.min.x, second.min.x)) != cell.x || Coordinate(std::max(first.min.y, second.min.y)) != cell.y) {
+						continue;
+					}
+					Id i = ids[in_cell[a]];
+					Id j = ids[in_cell[b]];
+					out.push_back(i < j ? Pair{ i, j } : Pair{ j, i });
+				}
+			}
+		}
+		stats.box_tests = tests;
+		stats.pairs = out.size();
+	}
+}
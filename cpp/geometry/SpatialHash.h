@@ -0,0 +1,71 @@
+#ifndef _GEOMETRY_SPATIALHASH_H
+#define _GEOMETRY_SPATIALHASH_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Broadphase.h"
+
+namespace Geometry {
+
+	/* Uniform grid, hashed: every box goes into each cell it covers, and only boxes sharing a cell get tested
+	against each other. The cells live in an open addressing table (linear probing) keyed by their grid
+	coordinates, so the grid is unbounded and costs nothing where there is nothing.
+
+	The table is rebuilt from scratch whenever the boxes changed, in O(n): count the boxes per cell, then lay
+	their entries out back to back, cell after cell, in one array. No per-cell lists, no allocation once the
+	arrays have grown.
+
+	Two boxes can share several cells, but the corner where their overlap starts (its min corner) is in exactly
+	one of them; the pair is only reported from that cell, so nothing needs to remember what was seen.
+
+	Best when the boxes are about the same size and the cells a bit bigger than them: each box then lands in
+	one to four cells. A box many cells across goes into all of them, so for very mixed sizes the DynamicTree
+	does better.
+	*/
+	class SpatialHash : public Broadphase {
+
+	public:
+		// Twice the 20 unit hulls the window draws.
+		static constexpr double DefaultCellSize = 32.0;
+
+		explicit SpatialHash(double cell_size = DefaultCellSize);
+
+		void Add(Id id, const Aabb& box) override;
+		void Move(Id id, const Aabb& box) override;
+		void Remove(Id id) override;
+		void Build() override;
+		void FindPairs(std::vector<Pair>& out) override;
+		const char* Name() const override { return "spatial hash"; }
+
+		// Of the last Build: cells with something in them, and box entries over all of them.
+		size_t Cells() const { return occupied; }
+		size_t Entries() const { return entries.size(); }
+
+	private:
+		struct Cell {
+			int32_t x;
+			int32_t y;
+			uint32_t start;		// Into entries.
+			uint32_t count;		// 0 for empty slots.
+		};
+
+		double inverse;			// 1 / cell size.
+		std::vector<Aabb> boxes;
+		std::vector<Id> ids;
+		std::vector<size_t> slots;		// By id: index into boxes and ids.
+
+		std::vector<Cell> table;
+		std::vector<uint32_t> entries;	// Indices into boxes, grouped by cell.
+		std::vector<uint32_t> entry_cells;
+		size_t occupied;
+		bool built;
+
+		int32_t Coordinate(double value) const;
+		uint32_t Find(int32_t x, int32_t y);
+	};
+}
+
+#endif
@@ -0,0 +1,177 @@
+#include "StreamingHull.h"
+
+#include "MergeHull.h"
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#define GEOMETRY_MMAP 1
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <cstdio>
+#endif
+
+namespace Geometry {
+
+	StreamingHull::StreamingHull(size_t chunk_size) : chunk_points(ChunkAlignment), points_seen(0), chunks(0), engine(std::vector<Point2D>()) {
+		if (chunk_size > ChunkAlignment) {
+			chunk_points = (chunk_size + ChunkAlignment - 1) / ChunkAlignment * ChunkAlignment;
+		}
+		engine.prefilter = true;
+	}
+
+	void StreamingHull::Add(const Point2D* points, size_t n) {
+		points_seen += n;
+		while (n > 0) {
+			// Whole chunks straight from the caller's memory (a file window, usually), no copy into pending.
+			if (pending.empty() && n >= chunk_points) {
+				Process(points, chunk_points);
+				points += chunk_points;
+				n -= chunk_points;
+				continue;
+			}
+
+			size_t take = chunk_points - pending.size();
+			if (take > n) {
+				take = n;
+			}
+			pending.insert(pending.end(), points, points + take);
+			points += take;
+			n -= take;
+			if (pending.size() == chunk_points) {
+				Process(pending.data(), pending.size());
+				pending.clear();
+			}
+		}
+	}
+
+	/* Hull of the chunk, then the hull of the two hulls. MergeHull::Merge does that in time linear in the two
+	hulls, and when the input comes in x order (sorted files, tiles) by walking the bridges between them.
+	*/
+	void StreamingHull::Process(const Point2D* points, size_t n) {
+		chunks++;
+		engine.points.assign(points, points + n);
+		engine.GetConvexHull();
+		if (hull.empty()) {
+			hull = engine.hull;
+			return;
+		}
+		hull = MergeHull::Merge(hull, engine.hull);
+	}
+
+	const std::vector<Point2D>& StreamingHull::Hull() {
+		if (!pending.empty()) {
+			Process(pending.data(), pending.size());
+			pending.clear();
+		}
+		return hull;
+	}
+
+#if defined(_WIN32)
+
+	bool StreamingHull::AddFile(const std::string& path) {
+		HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file == INVALID_HANDLE_VALUE) {
+			return false;
+		}
+		LARGE_INTEGER size;
+		if (!GetFileSizeEx(file, &size) || size.QuadPart % sizeof(Point2D) != 0) {
+			CloseHandle(file);
+			return false;
+		}
+		if (size.QuadPart == 0) {
+			CloseHandle(file);
+			return true;
+		}
+
+		HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping == nullptr) {
+			CloseHandle(file);
+			return false;
+		}
+
+		const uint64_t total = (uint64_t)size.QuadPart;
+		const uint64_t window = (uint64_t)chunk_points * sizeof(Point2D);
+		bool ok = true;
+		for (uint64_t offset = 0; offset < total; offset += window) {
+			size_t length = (size_t)(total - offset < window ? total - offset : window);
+			const void* view = MapViewOfFile(mapping, FILE_MAP_READ, (DWORD)(offset >> 32), (DWORD)offset, length);
+			if (view == nullptr) {
+				ok = false;
+				break;
+			}
+			Add(static_cast<const Point2D*>(view), length / sizeof(Point2D));
+			UnmapViewOfFile(view);
+		}
+		CloseHandle(mapping);
+		CloseHandle(file);
+		return ok;
+	}
+
+#elif defined(GEOMETRY_MMAP)
+
+	bool StreamingHull::AddFile(const std::string& path) {
+		int file = open(path.c_str(), O_RDONLY);
+		if (file < 0) {
+			return false;
+		}
+		struct stat info;
+		if (fstat(file, &info) != 0 || info.st_size % sizeof(Point2D) != 0) {
+			close(file);
+			return false;
+		}
+
+		const uint64_t total = (uint64_t)info.st_size;
+		const uint64_t window = (uint64_t)chunk_points * sizeof(Point2D);
+		bool ok = true;
+		for (uint64_t offset = 0; offset < total; offset += window) {
+			size_t length = (size_t)(total - offset < window ? total - offset : window);
+			void* view = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, file, (off_t)offset);
+			if (view == MAP_FAILED) {
+				ok = false;
+				break;
+			}
+			madvise(view, length, MADV_SEQUENTIAL);
+			Add(static_cast<const Point2D*>(view), length / sizeof(Point2D));
+			munmap(view, length);
+		}
+		close(file);
+		return ok;
+	}
+
+#else
+
+	// No mapping API: plain reads into one chunk-sized buffer.
+	bool StreamingHull::AddFile(const std::string& path) {
+		std::FILE* file = std::fopen(path.c_str(), "rb");
+		if (file == nullptr) {
+			return false;
+		}
+		std::vector<Point2D> buffer(chunk_points);
+		bool ok = true;
+		while (true) {
+			size_t bytes = std::fread(buffer.data(), 1, chunk_points * sizeof(Point2D), file);
+			if (bytes % sizeof(Point2D) != 0) {
+				ok = false;
+			}
+			Add(buffer.data(), bytes / sizeof(Point2D));
+			if (bytes < chunk_points * sizeof(Point2D)) {
+				break;
+			}
+		}
+		ok = ok && !std::ferror(file);
+		std::fclose(file);
+		return ok;
+	}
+
+#endif
+}
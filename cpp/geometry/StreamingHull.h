@@ -0,0 +1,66 @@
+#ifndef _GEOMETRY_STREAMINGHULL_H
+#define _GEOMETRY_STREAMINGHULL_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Point2D.h"
+#include "QuickHull.h"
+
+namespace Geometry {
+
+	/* Convex hull of more points than fit in memory, fed in pieces.
+
+	Points are collected into chunks of a fixed size. Every full chunk gets its own hull (QuickHull with the
+	octagon pre-filter), which is then merged into the running hull; after that nothing of the chunk is kept.
+	So memory stays at a few chunk-sized buffers plus the hull, however many points go through.
+
+	Files are read the same way: AddFile maps one chunk-sized window of the file at a time (read in chunks
+	where there is no mmap), so the page cache can drop what has been hulled already.
+
+	The result has the same contract as the other engines and is the exact hull of everything added.
+	*/
+	class StreamingHull {
+
+	public:
+		static const size_t DefaultChunkPoints = 1 << 20;
+
+		// Chunk sizes are rounded up to a multiple of this many points (64 KB), so file windows start on a
+		// mapping boundary everywhere (Windows maps at 64 KB granularity).
+		static const size_t ChunkAlignment = 4096;
+
+		explicit StreamingHull(size_t chunk_size = DefaultChunkPoints);
+
+		// Any number of points at a time; they are buffered until a chunk is full.
+		void Add(const Point2D* points, size_t n);
+
+		/* Adds a whole point file: Point2D records back to back (x then y, native-endian doubles, 16 bytes
+		each), no header. Returns false if the file cannot be opened or mapped or its size is not a whole
+		number of records; points from windows read before a failure stay added.
+		*/
+		bool AddFile(const std::string& path);
+
+		// Hulls whatever is still buffered first.
+		const std::vector<Point2D>& Hull();
+
+		uint64_t Points() const { return points_seen; }
+		uint64_t Chunks() const { return chunks; }
+		size_t ChunkPoints() const { return chunk_points; }
+
+	private:
+		size_t chunk_points;
+		uint64_t points_seen;
+		uint64_t chunks;
+
+		std::vector<Point2D> pending;
+		std::vector<Point2D> hull;
+		QuickHull engine;
+
+		void Process(const Point2D* points, size_t n);
+	};
+}
+
+#endif
@@ -0,0 +1,54 @@
+#include "SupportShape.h"
+
+#include "HullMath.h"
+
+namespace Geometry {
+
+	PolygonShape::PolygonShape(const Point2D* hull, size_t n) : vertices(hull), count(n), center(Point2D{ 0, 0 }) {
+		for (size_t i = 0; i < n; i++) {
+			center = center + vertices[i];
+		}
+		if (n > 0) {
+			center = (1.0 / n) * center;
+		}
+	}
+
+	PolygonShape::PolygonShape(const std::vector<Point2D>& hull) : PolygonShape(hull.data(), hull.size()) {}
+
+	Point2D PolygonShape::Support(const Point2D& direction) const {
+		size_t best = 0;
+		double best_dot = Dot(vertices[0], direction);
+		for (size_t i = 1; i < count; i++) {
+			double dot = Dot(vertices[i], direction);
+			if (dot > best_dot) {
+				best_dot = dot;
+				best = i;
+			}
+		}
+		return vertices[best];
+	}
+
+	std::vector<Point2D> PolygonShape::Materialize() const {
+		return std::vector<Point2D>(vertices, vertices + count);
+	}
+
+	MinkowskiDifferenceShape::MinkowskiDifferenceShape(const SupportShape& first, const SupportShape& second) : first(first), second(second) {}
+
+	Point2D MinkowskiDifferenceShape::Support(const Point2D& direction) const {
+		return first.Support(direction) - second.Support(-direction);
+	}
+
+	Point2D MinkowskiDifferenceShape::Support(const Point2D& direction, Point2D& on_first, Point2D& on_second) const {
+		on_first = first.Support(direction);
+		on_second = second.Support(-direction);
+		return on_first - on_second;
+	}
+
+	Point2D MinkowskiDifferenceShape::Center() const {
+		return first.Center() - second.Center();
+	}
+
+	std::vector<Point2D> MinkowskiDifferenceShape::Materialize() const {
+		return HullMath::ConvexMinkowskiDiff(first.Materialize(), second.Materialize());
+	}
+}
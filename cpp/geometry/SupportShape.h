@@ -0,0 +1,75 @@
+#ifndef _GEOMETRY_SUPPORTSHAPE_H
+#define _GEOMETRY_SUPPORTSHAPE_H
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Point2D.h"
+
+namespace Geometry {
+
+	/* A convex shape known only by its support function: the point of the shape furthest along a direction.
+	That is all the collision queries (Gjk, Epa) ever ask of a shape, so a shape never has to be a vertex
+	list unless someone wants to draw it; Materialize builds that.
+	*/
+	class SupportShape {
+
+	public:
+		virtual ~SupportShape() {}
+
+		// A point of the shape with the largest dot product with direction; any of them on a tie.
+		virtual Point2D Support(const Point2D& direction) const = 0;
+
+		// Some point inside (or on) the shape. Queries start looking from here.
+		virtual Point2D Center() const = 0;
+
+		// The shape as a hull (the usual contract).
+		virtual std::vector<Point2D> Materialize() const = 0;
+	};
+
+	/* A hull (at least one vertex) seen as a shape. It only points at the vertices, which have to outlive it
+	and stay put; support is a scan over them, O(n).
+	*/
+	class PolygonShape : public SupportShape {
+
+	public:
+		PolygonShape(const Point2D* hull, size_t n);
+		explicit PolygonShape(const std::vector<Point2D>& hull);
+
+		Point2D Support(const Point2D& direction) const override;
+		Point2D Center() const override { return center; }
+		std::vector<Point2D> Materialize() const override;
+
+	private:
+		const Point2D* vertices;
+		size_t count;
+		Point2D center;
+	};
+
+	/* first - second, without ever building it: support(d) is first's support along d minus second's along -d.
+	Both shapes are held by reference. Materialize merges the two hulls' edges (HullMath::ConvexMinkowskiDiff),
+	which is only worth it for drawing.
+	*/
+	class MinkowskiDifferenceShape : public SupportShape {
+
+	public:
+		MinkowskiDifferenceShape(const SupportShape& first, const SupportShape& second);
+
+		Point2D Support(const Point2D& direction) const override;
+		Point2D Center() const override;
+		std::vector<Point2D> Materialize() const override;
+
+		// Support that also hands back the two points it came from; the queries need those for contact points.
+		Point2D Support(const Point2D& direction, Point2D& on_first, Point2D& on_second) const;
+
+		const SupportShape& First() const { return first; }
+		const SupportShape& Second() const { return second; }
+
+	private:
+		const SupportShape& first;
+		const SupportShape& second;
+	};
+}
+
+#endif
@@ -0,0 +1,106 @@
+#include "SweepAndPrune.h"
+
+#include <algorithm>
+
+namespace Geometry {
+
+	namespace {
+
+		// More than this share of the boxes new since the last sort, and a full sort is quicker.
+		const size_t FullSortShare = 8;
+	}
+
+	SweepAndPrune::SweepAndPrune(Axis axis) : axis(axis), added(0), swaps(0), sorted(true) {}
+
+	void SweepAndPrune::Add(Id id, const Aabb& box) {
+		if (id >= boxes.size()) {
+			boxes.resize((size_t)id + 1);
+			active_at.resize((size_t)id + 1);
+		}
+		boxes[id] = box;
+		endpoints.push_back(Endpoint{ 0, id, 0 });
+		endpoints.push_back(Endpoint{ 0, id, 1 });
+		added++;
+		sorted = false;
+	}
+
+	void SweepAndPrune::Move(Id id, const Aabb& box) {
+		boxes[id] = box;
+		sorted = false;
+	}
+
+	void SweepAndPrune::Remove(Id id) {
+		endpoints.erase(std::remove_if(endpoints.begin(), endpoints.end(), [id](const Endpoint& e) { return e.id == id; }), endpoints.end());
+	}
+
+	/* Values come fresh from the boxes first, so Move is only a store. The order is by value, starts before ends,
+	which is a strict weak order, so the insertion sort and std::sort agree.
+	*/
+	void SweepAndPrune::Sort() {
+		for (Endpoint& e : endpoints) {
+			const Aabb& box = boxes[e.id];
+			const Point2D& corner = e.is_max ? box.max : box.min;
+			e.value = axis == X ? corner.x : corner.y;
+		}
+		auto less = [](const Endpoint& a, const Endpoint& b) {
+			return a.value < b.value || (a.value == b.value && a.is_max < b.is_max);
+		};
+
+		swaps = 0;
+		if (added * FullSortShare > endpoints.size() / 2) {
+			std::sort(endpoints.begin(), endpoints.end(), less);
+		}
+		else {
+			for (size_t i = 1; i < endpoints.size(); i++) {
+				Endpoint e = endpoints[i];
+				size_t j = i;
+				while (j > 0 && less(e, endpoints[j - 1])) {
+					endpoints[j] = endpoints[j - 1];
+					j--;
+				}
+				endpoints[j] = e;
+				swaps += i - j;
+			}
+		}
+		added = 0;
+		sorted = true;
+	}
+
+	void SweepAndPrune::Build() {
+		Sort();
+	}
+
+	void SweepAndPrune::FindPairs(std::vector<Pair>& out) {
+		if (!sorted) {
+			Sort();
+		}
+		out.clear();
+		active.clear();
+		uint64_t tests = 0;
+		for (const Endpoint& e : endpoints) {
+			if (e.is_max) {
+				size_t at = active_at[e.id];
+				active[at] = active.back();
+				active_at[active[at]] = at;
+				active.pop_back();
+				continue;
+			}
+
+			// Everything active overlaps this box on the sweep axis already.
+			const Aabb& box = boxes[e.id];
+			for (Id other : active) {
+				const Aabb& other_box = boxes[other];
+				tests++;
+				bool overlap = axis == X ? (box.min.y <= other_box.max.y && other_box.min.y <= box.max.y)
+					: (box.min.x <= other_box.max.x && other_box.min.x <= box.max.x);
+				if (overlap) {
+					out.push_back(e.id < other ? Pair{ e.id, other } : Pair{ other, e.id });
+				}
+			}
+			active_at[e.id] = active.size();
+			active.push_back(e.id);
+		}
+		stats.box_tests = tests;
+		stats.pairs = out.size();
+	}
+}
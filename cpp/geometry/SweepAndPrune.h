@@ -0,0 +1,62 @@
+#ifndef _GEOMETRY_SWEEPANDPRUNE_H
+#define _GEOMETRY_SWEEPANDPRUNE_H
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Broadphase.h"
+
+namespace Geometry {
+
+	/* Sweep and prune: the boxes' two ends on one axis in one sorted list, swept from low to high.
+
+	Between a box's start and end, every box whose start came earlier and whose end has not come yet overlaps it
+	on the sweep axis; only those get the other axis tested. Boxes that never meet on the sweep axis are never
+	even looked at together, so with little overlap along it the sweep is close to O(n).
+
+	The list stays sorted from frame to frame: moves only change the values, and FindPairs puts the list back in
+	order with an insertion sort, which for things that moved a little is a handful of swaps per box. Adding
+	many boxes at once falls back to a full sort.
+
+	Sweep along the axis the scene is spread out more on; x by default.
+	*/
+	class SweepAndPrune : public Broadphase {
+
+	public:
+		enum Axis { X, Y };
+
+		explicit SweepAndPrune(Axis axis = X);
+
+		void Add(Id id, const Aabb& box) override;
+		void Move(Id id, const Aabb& box) override;
+		void Remove(Id id) override;
+		void Build() override;
+		void FindPairs(std::vector<Pair>& out) override;
+		const char* Name() const override { return "sweep and prune"; }
+
+		// Swaps the last FindPairs' insertion sort took (0 after a full sort).
+		uint64_t LastSwaps() const { return swaps; }
+
+	private:
+		struct Endpoint {
+			double value;
+			Id id;
+			uint32_t is_max;	// Starts sort before ends at the same value, so touching boxes overlap.
+		};
+
+		Axis axis;
+		std::vector<Aabb> boxes;		// By id.
+		std::vector<Endpoint> endpoints;
+		std::vector<Id> active;
+		std::vector<size_t> active_at;	// By id: where in active.
+		size_t added;					// Boxes added since the last sort.
+		uint64_t swaps;
+		bool sorted;
+
+		void Sort();
+	};
+}
+
+#endif
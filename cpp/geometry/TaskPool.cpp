@@ -0,0 +1,130 @@
+#include "TaskPool.h"
+
+namespace Geometry {
+
+	namespace {
+		// Which pool (if any) the current thread works for, and which queue is its own.
+		thread_local const TaskPool* current_pool = nullptr;
+		thread_local size_t current_queue = 0;
+	}
+
+	TaskPool::TaskPool(unsigned threads) : queued(0), stopping(false) {
+		if (threads == 0) {
+			threads = std::thread::hardware_concurrency();
+		}
+		if (threads == 0) {
+			threads = 1;
+		}
+
+		for (unsigned i = 0; i < threads; i++) {
+			queues.push_back(std::unique_ptr<Queue>(new Queue()));
+		}
+		for (unsigned i = 0; i + 1 < threads; i++) {
+			workers.emplace_back([this, i]() { WorkerLoop(i); });
+		}
+	}
+
+	TaskPool::~TaskPool() {
+		stopping = true;
+		{
+			std::lock_guard<std::mutex> guard(sleep_lock);
+		}
+		wake.notify_all();
+		for (size_t i = 0; i < workers.size(); i++) {
+			workers[i].join();
+		}
+	}
+
+	TaskPool& TaskPool::Default() {
+		static TaskPool pool;
+		return pool;
+	}
+
+	size_t TaskPool::CurrentQueue() const {
+		return current_pool == this ? current_queue : queues.size() - 1;
+	}
+
+	void TaskPool::Submit(Task task) {
+		Queue& queue = *queues[CurrentQueue()];
+		{
+			std::lock_guard<std::mutex> guard(queue.lock);
+			queue.tasks.push_back(std::move(task));
+		}
+		queued++;
+
+		// Taking the sleep lock orders this against a worker that just found nothing to do and is about to sleep.
+		{
+			std::lock_guard<std::mutex> guard(sleep_lock);
+		}
+		wake.notify_one();
+	}
+
+	bool TaskPool::Pop(size_t index, Task& task) {
+		Queue& queue = *queues[index];
+		std::lock_guard<std::mutex> guard(queue.lock);
+		if (queue.tasks.empty()) {
+			return false;
+		}
+		task = std::move(queue.tasks.back());
+		queue.tasks.pop_back();
+		return true;
+	}
+
+	bool TaskPool::Steal(size_t thief, Task& task) {
+		for (size_t offset = 1; offset < queues.size(); offset++) {
+			Queue& queue = *queues[(thief + offset) % queues.size()];
+			std::lock_guard<std::mutex> guard(queue.lock);
+			if (!queue.tasks.empty()) {
+				task = std::move(queue.tasks.front());
+				queue.tasks.pop_front();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool TaskPool::TryRun(size_t home) {
+		Task task;
+		if (!Pop(home, task) && !Steal(home, task)) {
+			return false;
+		}
+		queued--;
+		task.work();
+		task.group->pending.fetch_sub(1, std::memory_order_release);
+		return true;
+	}
+
+	void TaskPool::WorkerLoop(size_t index) {
+		current_pool = this;
+		current_queue = index;
+
+		while (!stopping) {
+			if (TryRun(index)) {
+				continue;
+			}
+			std::unique_lock<std::mutex> guard(sleep_lock);
+			wake.wait(guard, [this]() { return stopping || queued > 0; });
+		}
+	}
+
+	TaskGroup::TaskGroup(TaskPool& pool) : pool(pool), pending(0) {
+	}
+
+	TaskGroup::~TaskGroup() {
+		Wait();
+	}
+
+	void TaskGroup::Run(std::function<void()> work) {
+		pending.fetch_add(1, std::memory_order_relaxed);
+		pool.Submit(TaskPool::Task{ std::move(work), this });
+	}
+
+	void TaskGroup::Wait() {
+		const size_t home = pool.CurrentQueue();
+		while (pending.load(std::memory_order_acquire) != 0) {
+			if (!pool.TryRun(home)) {
+				std::this_thread::yield();
+			}
+		}
+	}
+}
@@ -0,0 +1,96 @@
+#ifndef _GEOMETRY_TASKPOOL_H
+#define _GEOMETRY_TASKPOOL_H
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Geometry {
+
+	class TaskGroup;
+
+	/* Small work-stealing scheduler for the divide and conquer hull code.
+
+	Every worker owns a deque: it pushes and pops its own tasks at the back (newest first, which keeps the
+	recursion depth-first and cache friendly) while idle workers steal from the front of someone else's deque
+	(oldest first, i.e. the biggest sub-problems). Threads outside the pool submit into an extra shared deque.
+	A thread waiting on a TaskGroup keeps executing tasks instead of blocking, so nested groups cannot deadlock.
+
+	TaskPool(n) runs n - 1 worker threads; the thread that waits on a group is the n-th.
+	*/
+	class TaskPool {
+
+	public:
+		explicit TaskPool(unsigned threads = 0);
+		~TaskPool();
+
+		TaskPool(const TaskPool&) = delete;
+		TaskPool& operator=(const TaskPool&) = delete;
+
+		// Worker threads plus the calling thread.
+		unsigned ThreadCount() const { return (unsigned)workers.size() + 1; }
+
+		// Shared pool sized to the machine.
+		static TaskPool& Default();
+
+	private:
+		friend class TaskGroup;
+
+		struct Task {
+			std::function<void()> work;
+			TaskGroup* group;
+		};
+
+		struct Queue {
+			std::mutex lock;
+			std::deque<Task> tasks;
+		};
+
+		std::vector<std::thread> workers;
+		// One queue per worker, the last one takes submissions from outside the pool.
+		std::vector<std::unique_ptr<Queue>> queues;
+
+		std::mutex sleep_lock;
+		std::condition_variable wake;
+		std::atomic<size_t> queued;
+		std::atomic<bool> stopping;
+
+		void Submit(Task task);
+		bool TryRun(size_t home);
+		bool Pop(size_t queue, Task& task);
+		bool Steal(size_t thief, Task& task);
+		void WorkerLoop(size_t index);
+		size_t CurrentQueue() const;
+	};
+
+	// A set of tasks that can be waited on together.
+	class TaskGroup {
+
+	public:
+		explicit TaskGroup(TaskPool& pool);
+		~TaskGroup();
+
+		TaskGroup(const TaskGroup&) = delete;
+		TaskGroup& operator=(const TaskGroup&) = delete;
+
+		void Run(std::function<void()> work);
+
+		// Returns once every task passed to Run has finished. Runs queued tasks (from any group) meanwhile.
+		void Wait();
+
+	private:
+		friend class TaskPool;
+
+		TaskPool& pool;
+		std::atomic<size_t> pending;
+	};
+}
+
+#endif
@@ -3,16 +3,24 @@
 #include <d2d1.h>
 
 #include <algorithm>
-#include <list>
-#include <memory>
+#include <cwchar>
+#include <vector>
 using namespace std;
 
 #pragma comment(lib, "d2d1")
 
 #include "basewin.h"
 #include "resource.h"
-#include "QuickHull.cpp"
-#include "HullMath.cpp"
+#include "GeometryAdapter.h"
+#include "geometry/DynamicHull.h"
+#include "geometry/Epa.h"
+#include "geometry/GjkCache.h"
+#include "geometry/HullCache.h"
+#include "geometry/HullMath.h"
+#include "geometry/MonotoneChain.h"
+#include "geometry/PickIndex.h"
+#include "geometry/PointStore.h"
+#include "geometry/SupportShape.h"
 
 template <class T> void SafeRelease(T **ppT)
 {
@@ -63,31 +71,6 @@ public:
 
 float DPIScale::scaleX = 1.0f;
 float DPIScale::scaleY = 1.0f;
-D2D1_ELLIPSE first_point;
-
-struct MyEllipse
-{
-    D2D1_ELLIPSE    ellipse;
-    D2D1_COLOR_F    color;
-
-    void Draw(ID2D1RenderTarget *pRT, ID2D1SolidColorBrush *pBrush)
-    {
-        pBrush->SetColor(color);
-        pRT->FillEllipse(ellipse, pBrush);
-        pBrush->SetColor(D2D1::ColorF(D2D1::ColorF::Black));
-        pRT->DrawEllipse(ellipse, pBrush, 1.0f);
-    }
-
-    BOOL HitTest(float x, float y)
-    {
-        const float a = ellipse.radiusX;
-        const float b = ellipse.radiusY;
-        const float x1 = x - ellipse.point.x;
-        const float y1 = y - ellipse.point.y;
-        const float d = ((x1 * x1) / (a * a)) + ((y1 * y1) / (b * b));
-        return d <= 1.0f;
-    }
-};
 
 D2D1::ColorF::Enum colors[] = { D2D1::ColorF::Yellow, D2D1::ColorF::Salmon, D2D1::ColorF::LimeGreen };
 
@@ -238,32 +221,58 @@ class AlgorithmWindow : public BaseWindow<AlgorithmWindow>
     Mode                    mode;
     size_t                  nextColor;
 
-    list<shared_ptr<MyEllipse>>             ellipses;
-    list<shared_ptr<MyEllipse>>::iterator   selection;
+    // The draggable points, in draw order: handle i is what used to be the i-th ellipse (0 to 9 mirror big_points
+    // or small_points, 10 is the query point). selection is a handle, so it survives points coming and going.
+    Geometry::PointStore handles;
+    Geometry::PointStore::Handle selection;
+
+    // Clicks go through these. handle_picks holds every handle by its slot, later ones on top like they are
+    // drawn; hull_picks the bounds of the hulls that can be dragged, by their move_ind.
+    Geometry::PickIndex handle_picks;
+    Geometry::PickIndex hull_picks;
+    vector<Geometry::PickIndex::Id> picked_hulls;
 
     // Don't worry about these two, Will - they're for QuickHull and Point Convex, which will not be moved.
     vector<D2D1_ELLIPSE> big_points;
     vector<D2D1_ELLIPSE> small_points;
 
+    // Hull of big_points, updated point by point as they get dragged instead of rebuilt on every paint.
+    // point_handles[i] is big_points[i].
+    Geometry::DynamicHull point_hull;
+    vector<Geometry::DynamicHull::Handle> point_handles;
+
     // These are the movable hulls!
     vector<D2D1_ELLIPSE> hull1;
     vector<D2D1_ELLIPSE> hull2;
 
     vector<D2D1_ELLIPSE> static_hull;
 
-    shared_ptr<MyEllipse> Selection()
-    {
-        if (selection == ellipses.end())
-        {
-            return nullptr;
-        }
-        else
-        {
-            return (*selection);
-        }
-    }
-
-    void    ClearSelection() { selection = ellipses.end(); }
+    // Every hull on screen is cached against version counters of the points it comes from, and whatever edits
+    // those points touches their input. Paint and hit-testing share the hulls; a frame without edits rebuilds
+    // nothing (the window repaints continuously, so that is most frames).
+    Geometry::HullCache hull_cache;
+    Geometry::GjkCache gjk_cache;                   // hull1 against hull2 starts from where it ended last time.
+    Geometry::HullCache::Input hull1_input;         // small_points[0, 5)
+    Geometry::HullCache::Input hull2_input;         // small_points[5, 10)
+    Geometry::HullCache::Input big_points_input;
+    Geometry::HullCache::Input query_input;         // The point PointHull tests against the hull.
+    Geometry::HullCache::Input view_input;          // The Minkowski hulls are drawn around the middle of the view.
+    Geometry::HullCache::Entry hull1_entry;
+    Geometry::HullCache::Entry hull2_entry;
+    Geometry::HullCache::Entry mink_diff_entry;
+    Geometry::HullCache::Entry mink_sum_entry;
+    Geometry::HullCache::Entry point_hull_entry;
+    Geometry::HullCache::Entry touching_entry;
+    Geometry::HullCache::Entry query_inside_entry;
+    bool hulls_touching;
+    Geometry::Epa::Contact hull_contact;    // How deep hull1 is in hull2 while hulls_touching.
+    bool query_inside;
+    D2D1_SIZE_U view_pixels;
+
+    bool    HasSelection() { return handles.Valid(selection); }
+    size_t  SelectedIndex() { return handles.IndexOf(selection); }
+    void    ClearSelection() { selection = Geometry::PointStore::Handle(); }
+    D2D1_ELLIPSE HandleEllipse(size_t index);
     //HRESULT InsertEllipse(float x, float y);
 
     /*MyEllipse PointFarthestFromEdge(MyEllipse a, MyEllipse b, list<shared_ptr<MyEllipse>> p);
@@ -280,9 +289,22 @@ class AlgorithmWindow : public BaseWindow<AlgorithmWindow>
     void    OnMouseMove(int pixelX, int pixelY, DWORD flags);
     void    OnKeyDown(UINT vkey);
     void    OnPaint();
-    void    RenderEdges(vector<D2D1_ELLIPSE> points);
+    void    RenderEdges(const vector<Geometry::Point2D>& points);
+    void    RenderContact();
     void    DrawAxes();
     void    UpdateEllipses();
+    bool    MoveHandle(size_t index, D2D1_POINT_2F point);
+    bool    MinkowskiMode();
+    void    UpdateHullBounds();
+    void    PointsMoved(size_t index);
+    void    ReportHullCache();
+    vector<D2D1_ELLIPSE> SmallPoints(size_t first);
+    const vector<Geometry::Point2D>& SortedHull1();
+    const vector<Geometry::Point2D>& SortedHull2();
+    const vector<Geometry::Point2D>& MinkowskiHull();
+    const vector<Geometry::Point2D>& CurrentPointHull();
+    bool    HullsTouching();
+    bool    QueryInside();
     D2D1_ELLIPSE point_convex;
 
     // Hull being moved
@@ -291,13 +313,24 @@ class AlgorithmWindow : public BaseWindow<AlgorithmWindow>
     // Index of moved hull
     int move_ind;
 
-    vector<D2D1_ELLIPSE> AlgorithmWindow::Translate(vector<D2D1_ELLIPSE> points, int dir);
-
 public:
 
     AlgorithmWindow() : pFactory(NULL), pRenderTarget(NULL), pBrush(NULL),
-        ptMouse(D2D1::Point2F()), nextColor(0), selection(ellipses.end())
+        ptMouse(D2D1::Point2F()), nextColor(0), hulls_touching(false), hull_contact(), query_inside(false),
+        view_pixels(D2D1::SizeU(0, 0))
     {
+        hull1_input = hull_cache.AddInput();
+        hull2_input = hull_cache.AddInput();
+        big_points_input = hull_cache.AddInput();
+        query_input = hull_cache.AddInput();
+        view_input = hull_cache.AddInput();
+        hull1_entry = hull_cache.AddEntry({ hull1_input });
+        hull2_entry = hull_cache.AddEntry({ hull2_input });
+        mink_diff_entry = hull_cache.AddEntry({ hull1_input, hull2_input, view_input });
+        mink_sum_entry = hull_cache.AddEntry({ hull1_input, hull2_input, view_input });
+        point_hull_entry = hull_cache.AddEntry({ big_points_input });
+        touching_entry = hull_cache.AddEntry({ hull1_input, hull2_input });
+        query_inside_entry = hull_cache.AddEntry({ big_points_input, query_input });
     }
 
     HRESULT InsertEllipse(float x, float y);
@@ -372,6 +405,14 @@ HRESULT AlgorithmWindow::CreateGraphicsResources()
             point_convex.point.y = pRenderTarget->GetSize().height / 2;
             InsertEllipse(point_convex.point.x, point_convex.point.y);
 
+            view_pixels = size;
+            hull_cache.Touch(hull1_input);
+            hull_cache.Touch(hull2_input);
+            hull_cache.Touch(big_points_input);
+            hull_cache.Touch(query_input);
+            hull_cache.Touch(view_input);
+            UpdateHullBounds();
+
         }
     }
     return hr;
@@ -383,84 +424,191 @@ void AlgorithmWindow::DiscardGraphicsResources()
     SafeRelease(&pBrush);
 }
 
-int ComparePoints(const void* vp1, const void* vp2) {
-    D2D1_ELLIPSE* p1 = (D2D1_ELLIPSE*)vp1;
-    D2D1_ELLIPSE* p2 = (D2D1_ELLIPSE*)vp2;
+void AlgorithmWindow::RenderEdges(const vector<Geometry::Point2D>& points) {
+    for (size_t i = 0; i < points.size(); i++) {
+        const Geometry::Point2D& a = points[i];
+        const Geometry::Point2D& b = points[(i + 1) % points.size()];
+        pRenderTarget->DrawLine(D2D1::Point2F((float)a.x, (float)a.y), D2D1::Point2F((float)b.x, (float)b.y), pBrush);
+    }
+}
+
+// The way out of an overlap: the deepest points of the two hulls joined, and hull1 where it has to move to
+// only just touch hull2.
+void AlgorithmWindow::RenderContact() {
+    const Geometry::Point2D& a = hull_contact.point_a;
+    const Geometry::Point2D& b = hull_contact.point_b;
+    pRenderTarget->DrawLine(D2D1::Point2F((float)a.x, (float)a.y), D2D1::Point2F((float)b.x, (float)b.y), pBrush, 3.0f);
 
-    int ori = HullMath::PointOri(first_point, *p1, *p2);
-    if (ori == 0) {
-        return (HullMath::PointDistance(first_point, *p2) >= HullMath::PointDistance(first_point, *p1)) ? -1 : 1;
+    vector<Geometry::Point2D> resolved = SortedHull1();
+    for (Geometry::Point2D& point : resolved) {
+        point = point - hull_contact.depth * hull_contact.normal;
+    }
+    RenderEdges(resolved);
+}
+
+// Handles 0 to 9 show big_points or small_points, whichever the algorithm drags; only the ones that moved
+// cost anything.
+void AlgorithmWindow::UpdateEllipses() {
+    const vector<D2D1_ELLIPSE>& points = current_alg == QHull || current_alg == PointHull ? big_points : small_points;
+    bool moved = false;
+    for (size_t index = 0; index < 10 && index < handles.Size() && index < points.size(); index++) {
+        moved = MoveHandle(index, points[index].point) || moved;
+    }
+    if (moved) {
+        UpdateHullBounds();
     }
-    return (ori == 2) ? -1 : 1;
+}
 
+D2D1_ELLIPSE AlgorithmWindow::HandleEllipse(size_t index) {
+    const float radius = (float)handles.Radii()[index];
+    return D2D1::Ellipse(D2D1::Point2F((float)handles.X()[index], (float)handles.Y()[index]), radius, radius);
 }
 
-vector<D2D1_ELLIPSE> SortPoints(vector<D2D1_ELLIPSE> points) {
-    int min_y = points[0].point.y;
-    int min = 0;
+// Runs on every paint, so only a handle that really moved touches the store and the pick index.
+bool AlgorithmWindow::MoveHandle(size_t index, D2D1_POINT_2F point) {
+    Geometry::Point2D position = { point.x, point.y };
+    if (handles.Position(index) == position) {
+        return false;
+    }
+    handles.SetPosition(index, position);
+    handle_picks.Move(handles.HandleAt(index).slot, position);
+    return true;
+}
 
-    for (int i = 0; i < points.size(); i++) {
-        int y = points[i].point.y;
+bool AlgorithmWindow::MinkowskiMode() {
+    return current_alg == MinkDiff || current_alg == MinkSum || current_alg == GJK;
+}
 
-        if ((y < min_y) || (min_y == y && points[i].point.x < points[min].point.x)) {
-            min_y = points[i].point.y;
-            min = i;
+// A hull's bounds are its points' bounds, so the boxes follow the handles without any hull being built, read
+// straight out of the store: 1 and 2 around handles 0 to 4 and 5 to 9 while those show hull1 and hull2, 3 around
+// 0 to 9 while they show big_points. The other mode's boxes wait for it to come back (the handles all move
+// then). hull2 goes in after hull1 and wins where both hold the click, as it always did.
+void AlgorithmWindow::UpdateHullBounds() {
+    if (handles.Size() < 10) {
+        return;
+    }
+    const size_t firsts[] = { 0, 5, 0 };
+    const size_t counts[] = { 5, 5, 10 };
+    bool minkowski = MinkowskiMode();
+    for (Geometry::PickIndex::Id id = 1; id <= 3; id++) {
+        if ((id == 3) == minkowski && hull_picks.Has(id)) {
+            continue;
+        }
+        size_t first = firsts[id - 1];
+        Geometry::Aabb box = Geometry::BoundsOf(handles.X() + first, handles.Y() + first, counts[id - 1]);
+        if (hull_picks.Has(id)) {
+            hull_picks.Move(id, box);
+        }
+        else {
+            hull_picks.Insert(id, box);
         }
     }
+}
 
-    D2D1_ELLIPSE temp = points[0];
-    points[0] = points[min];
-    points[min] = temp;
+// The five small points starting at first: hull1 is 0 to 4, hull2 is 5 to 9.
+vector<D2D1_ELLIPSE> AlgorithmWindow::SmallPoints(size_t first) {
+    return vector<D2D1_ELLIPSE>(small_points.begin() + first, small_points.begin() + first + 5);
+}
 
-    first_point = points[0];
+// Touches whatever the moved ellipse feeds into. Index 10 is the query point of PointHull.
+void AlgorithmWindow::PointsMoved(size_t index) {
+    if (index == 10) {
+        hull_cache.Touch(query_input);
+    }
+    else if (current_alg == QHull || current_alg == PointHull) {
+        hull_cache.Touch(big_points_input);
+    }
+    else {
+        hull_cache.Touch(index < 5 ? hull1_input : hull2_input);
+    }
+}
 
-    qsort(&points[1], points.size() - 1, sizeof(D2D1_ELLIPSE), ComparePoints);
+const vector<Geometry::Point2D>& AlgorithmWindow::SortedHull1() {
+    return hull_cache.Get(hull1_entry, [this](vector<Geometry::Point2D>& hull) {
+        hull = Geometry::MonotoneChain::GetConvexHull(ToPoints(SmallPoints(0)));
+    });
+}
 
-    return points;
+const vector<Geometry::Point2D>& AlgorithmWindow::SortedHull2() {
+    return hull_cache.Get(hull2_entry, [this](vector<Geometry::Point2D>& hull) {
+        hull = Geometry::MonotoneChain::GetConvexHull(ToPoints(SmallPoints(5)));
+    });
 }
 
-vector<D2D1_ELLIPSE> AlgorithmWindow::Translate(vector<D2D1_ELLIPSE> points, int dir) {
-    vector<D2D1_ELLIPSE> translated;
-    for each (D2D1_ELLIPSE var in points) {
-        float x_co = var.point.x + ((pRenderTarget->GetSize().width / 2) * dir);
-        float y_co = var.point.y + ((pRenderTarget->GetSize().height / 2) * dir);
-        translated.push_back(D2D1::Ellipse(D2D1::Point2F(x_co, y_co), 10.0f, 10.0f));
-    }
-    return translated;
+// Sum or difference, whichever is on; both stay cached, so switching back and forth is free too.
+// Straight from the two hulls by merging their edges; the difference is the same lazy shape the collision
+// test runs on, only materialized for drawing. Both hulls are taken relative to the middle of the view,
+// so the sum moves back by the middle once and the difference comes out around it.
+const vector<Geometry::Point2D>& AlgorithmWindow::MinkowskiHull() {
+    bool sum = current_alg == MinkSum;
+    return hull_cache.Get(sum ? mink_sum_entry : mink_diff_entry, [this, sum](vector<Geometry::Point2D>& hull) {
+        D2D1_SIZE_F size = pRenderTarget->GetSize();
+        Geometry::Point2D middle = { size.width / 2.0, size.height / 2.0 };
+        if (sum) {
+            hull = Geometry::HullMath::ConvexMinkowskiSum(SortedHull1(), SortedHull2());
+            for (Geometry::Point2D& point : hull) {
+                point = point - middle;
+            }
+        }
+        else {
+            Geometry::PolygonShape first(SortedHull1());
+            Geometry::PolygonShape second(SortedHull2());
+            hull = Geometry::MinkowskiDifferenceShape(first, second).Materialize();
+            for (Geometry::Point2D& point : hull) {
+                point = point + middle;
+            }
+        }
+    });
 }
 
-void AlgorithmWindow::RenderEdges(vector<D2D1_ELLIPSE> points) {
-    for (size_t i = 0; i < points.size() - 1; i++) {
-        D2D1_POINT_2F point_a = D2D1::Point2F(points[i].point.x, points[i].point.y);
-        D2D1_POINT_2F point_b = D2D1::Point2F(points[i+1].point.x, points[i+1].point.y);
-        pRenderTarget->DrawLine(point_a, point_b, pBrush);
+// Only the points that actually moved since the last rebuild cost anything (a few tree updates each).
+const vector<Geometry::Point2D>& AlgorithmWindow::CurrentPointHull() {
+    return hull_cache.Get(point_hull_entry, [this](vector<Geometry::Point2D>& hull) {
+        for (size_t i = 0; i < big_points.size(); i++) {
+            if (i == point_handles.size()) {
+                point_handles.push_back(point_hull.Insert(ToPoint(big_points[i])));
+            }
+            else {
+                point_hull.Move(point_handles[i], ToPoint(big_points[i]));
+            }
+        }
+        Geometry::DynamicHull::View view = point_hull.Hull();
+        hull.assign(view.begin(), view.end());
+    });
+}
 
+bool AlgorithmWindow::HullsTouching() {
+    if (hull_cache.Refresh(touching_entry)) {
+        Geometry::PolygonShape first(SortedHull1());
+        Geometry::PolygonShape second(SortedHull2());
+        Geometry::MinkowskiDifferenceShape difference(first, second);
+        Geometry::Gjk::Result result = gjk_cache.Query(Geometry::GjkCache::PairKey(1, 2), difference);
+        hulls_touching = result.intersecting && Geometry::Epa::Penetration(difference, result.simplex, hull_contact);
     }
+    return hulls_touching;
+}
 
-    D2D1_POINT_2F point_a = D2D1::Point2F(points[points.size()-1].point.x, points[points.size()-1].point.y);
-    D2D1_POINT_2F point_b = D2D1::Point2F(points[0].point.x, points[0].point.y);
-    pRenderTarget->DrawLine(point_a, point_b, pBrush);
+bool AlgorithmWindow::QueryInside() {
+    if (hull_cache.Refresh(query_inside_entry)) {
+        query_inside = Geometry::HullMath::ContainsPoint(CurrentPointHull(), handles.Position(10));
+    }
+    return query_inside;
 }
 
-void AlgorithmWindow::UpdateEllipses() {
-    int index = 0;
-    if (current_alg == QHull || current_alg == PointHull) {
-        for (auto i = ellipses.begin(); i != ellipses.end(); ++i) {
-            if (index == 10)
-                break;
-            (*i)->ellipse.point.x = big_points[index].point.x;
-            (*i)->ellipse.point.y = big_points[index].point.y;
-            index++;
-        }
+// Every 300 frames, to the debugger output.
+void AlgorithmWindow::ReportHullCache() {
+    const Geometry::HullCache::Stats& stats = hull_cache.Totals();
+    if (stats.frames % 300 != 0) {
         return;
     }
-    for (auto i = ellipses.begin(); i != ellipses.end(); ++i) {
-        if (index == 10)
-            break;
-        (*i)->ellipse.point.x = small_points[index].point.x;
-        (*i)->ellipse.point.y = small_points[index].point.y;
-        index++;
-    }
+    wchar_t line[160];
+    swprintf_s(line, L"hull cache: %.1f%% hits (%llu lookups), %llu of %llu frames rebuilt nothing\n",
+        100.0 * hull_cache.HitRate(), (unsigned long long)(stats.hits + stats.misses),
+        (unsigned long long)stats.idle_frames, (unsigned long long)stats.frames);
+    OutputDebugStringW(line);
+    swprintf_s(line, L"gjk: %.2f iterations a query over %llu queries\n",
+        gjk_cache.AverageIterations(), (unsigned long long)gjk_cache.Totals().queries);
+    OutputDebugStringW(line);
 }
 
 void AlgorithmWindow::OnPaint()
@@ -477,112 +625,70 @@ void AlgorithmWindow::OnPaint()
 
 
         pBrush->SetColor(D2D1::ColorF(D2D1::ColorF::Black));
-        vector<D2D1_ELLIPSE> hullpoints;
 
-        int index = 0;
-        for (auto i = ellipses.begin(); i != ellipses.end(); ++i)
+        for (size_t index = 0; index < handles.Size(); index++)
         {
             if (index != 10) {
-                (hullpoints).push_back((*i)->ellipse);
-                pRenderTarget->DrawEllipse((*i)->ellipse, pBrush);
+                pRenderTarget->DrawEllipse(HandleEllipse(index), pBrush);
             }
-            index++;
         }
 
         UpdateEllipses();
 
-        if (current_alg == MinkDiff || current_alg == MinkSum || current_alg == GJK) {
+        if (MinkowskiMode()) {
 
             DrawAxes();
-            
-            for (int i = 0; i < 5; i++) {
-                hull1[i] = small_points[i];
-            }
-            for (int i = 0; i < 5; i++) {
-                hull2[i] = small_points[i+5];
-            }
-            
-            vector<D2D1_ELLIPSE> hull3;
-
-            if (current_alg == MinkDiff || current_alg == GJK) {
-                hull3 = Translate(HullMath::MinkowskiDiff(Translate(hull1, -1), Translate(hull2, -1)), 1);
-            }
-
-            if (current_alg == MinkSum) {
-                hull3 = Translate(HullMath::MinkowskiSum(Translate(hull1, -1), Translate(hull2, -1)), 1);
-            }
-
-            QuickHull* qhull1 = new QuickHull(hull1);
-            QuickHull* qhull2 = new QuickHull(hull2);
-            QuickHull* qhull3 = new QuickHull(hull3);
-
-            vector<D2D1_ELLIPSE> sorted_hull1 = SortPoints(qhull1->GetConvexHull());
-            vector<D2D1_ELLIPSE> sorted_hull2 = SortPoints(qhull2->GetConvexHull());
-            vector<D2D1_ELLIPSE> sorted_hull3 = SortPoints(qhull3->GetConvexHull());
-
 
             pBrush->SetColor(D2D1::ColorF(D2D1::ColorF::Red));
-            RenderEdges(sorted_hull1);
+            RenderEdges(SortedHull1());
 
             pBrush->SetColor(D2D1::ColorF(D2D1::ColorF::Blue));
-            RenderEdges(sorted_hull2);
+            RenderEdges(SortedHull2());
 
 
-            if (current_alg == GJK && HullMath::HullsIntersecting(sorted_hull1, sorted_hull2)) {
+            // Asked once a frame, so the cache's hit rate counts the paint once too.
+            bool touching = current_alg == GJK && HullsTouching();
+            if (touching) {
                 pBrush->SetColor(D2D1::ColorF(D2D1::ColorF::Green));
             }
             else {
                 pBrush->SetColor(D2D1::ColorF(D2D1::ColorF::Magenta));
             }
-            RenderEdges(sorted_hull3);
+            RenderEdges(MinkowskiHull());
+
+            if (touching) {
+                pBrush->SetColor(D2D1::ColorF(D2D1::ColorF::DarkOrange));
+                RenderContact();
+            }
         }
         // RENDERING QUICKHULL
         if (current_alg == QHull) {
-
-
-            QuickHull* qhull = new QuickHull(hullpoints);
-
-            vector<D2D1_ELLIPSE> q_points = (qhull)->GetConvexHull();
-
-            vector<D2D1_ELLIPSE> quick_hull_points = SortPoints(q_points);
-
-            RenderEdges(quick_hull_points);
+            RenderEdges(CurrentPointHull());
         }
 
         if (current_alg == PointHull) {
-            QuickHull* qhull = new QuickHull(hullpoints);
-
-            vector<D2D1_ELLIPSE> q_points = (qhull)->GetConvexHull();
+            RenderEdges(CurrentPointHull());
 
-            vector<D2D1_ELLIPSE> quick_hull_points = SortPoints(q_points);
-
-            D2D1_ELLIPSE point_check;
-
-            RenderEdges(quick_hull_points);
-
-            int index = 0;
-            for (auto i = ellipses.begin(); i != ellipses.end(); i++) {
+            for (size_t index = 0; index < handles.Size(); index++) {
                 if (index == 10) {
-                    point_check = (*i)->ellipse;
-                    if (HullMath::ContainsPoint(quick_hull_points, point_check)) {
+                    if (QueryInside()) {
                         pBrush->SetColor(D2D1::ColorF(D2D1::ColorF::Red));
                     }
                     else {
                         pBrush->SetColor(D2D1::ColorF(D2D1::ColorF::Green));
                     }
-                    pRenderTarget->FillEllipse((*i)->ellipse, pBrush);
+                    pRenderTarget->FillEllipse(HandleEllipse(index), pBrush);
                 }
                 else {
-                    pRenderTarget->DrawEllipse((*i)->ellipse, pBrush);
+                    pRenderTarget->DrawEllipse(HandleEllipse(index), pBrush);
                 }
-                index++;
             }
         }
 
-        if (Selection())
+        if (HasSelection())
         {
             pBrush->SetColor(D2D1::ColorF(D2D1::ColorF::Orange));
-            pRenderTarget->DrawEllipse(Selection()->ellipse, pBrush, 2.0f);
+            pRenderTarget->DrawEllipse(HandleEllipse(SelectedIndex()), pBrush, 2.0f);
         }
 
         hr = pRenderTarget->EndDraw();
@@ -591,6 +697,9 @@ void AlgorithmWindow::OnPaint()
             DiscardGraphicsResources();
         }
         EndPaint(m_hwnd, &ps);
+
+        hull_cache.EndFrame();
+        ReportHullCache();
     }
 }
 
@@ -603,6 +712,12 @@ void AlgorithmWindow::Resize()
 
         D2D1_SIZE_U size = D2D1::SizeU(rc.right, rc.bottom);
 
+        // This runs after every paint as well; only a real change of size moves the Minkowski hulls.
+        if (size.width != view_pixels.width || size.height != view_pixels.height) {
+            view_pixels = size;
+            hull_cache.Touch(view_input);
+        }
+
         pRenderTarget->Resize(size);
 
         InvalidateRect(m_hwnd, NULL, FALSE);
@@ -619,32 +734,19 @@ void AlgorithmWindow::OnLButtonDown(int pixelX, int pixelY, DWORD flags)
     pos.point.x = dipX;
     pos.point.y = dipY;
 
-    if (current_alg == MinkDiff || current_alg == MinkSum || current_alg == GJK) {
-        QuickHull* qhull1 = new QuickHull(hull1);
-        QuickHull* qhull2 = new QuickHull(hull2);
-
-        vector<D2D1_ELLIPSE> sorted_hull1 = SortPoints(qhull1->GetConvexHull());
-        vector<D2D1_ELLIPSE> sorted_hull2 = SortPoints(qhull2->GetConvexHull());
-
-        if (HullMath::ContainsPoint(sorted_hull1, pos)) {
-            moving_hull = hull1;
-            move_ind = 1;
-        }
-        if (HullMath::ContainsPoint(sorted_hull2, pos)) {
-            moving_hull = hull2;
-            move_ind = 2;
+    // Only a hull whose box holds the click gets looked at (the cached hull, nothing is rebuilt), topmost first.
+    bool minkowski = MinkowskiMode();
+    hull_picks.PickAll(ToPoint(pos), picked_hulls);
+    for (Geometry::PickIndex::Id hull : picked_hulls) {
+        if ((hull == 3) == minkowski) {
+            continue;
         }
-    }
-    else {
-        QuickHull* qhull1 = new QuickHull(big_points);
-
-        vector<D2D1_ELLIPSE> sorted_hull1 = SortPoints(qhull1->GetConvexHull());
-
-        if (HullMath::ContainsPoint(sorted_hull1, pos)) {
-            moving_hull = big_points;
-            move_ind = 3;
+        const vector<Geometry::Point2D>& points = hull == 1 ? SortedHull1() : hull == 2 ? SortedHull2() : CurrentPointHull();
+        if (Geometry::HullMath::ContainsPoint(points, ToPoint(pos))) {
+            moving_hull = hull == 1 ? SmallPoints(0) : hull == 2 ? SmallPoints(5) : big_points;
+            move_ind = (int)hull;
+            break;
         }
-
     }
 
     ClearSelection();
@@ -653,9 +755,9 @@ void AlgorithmWindow::OnLButtonDown(int pixelX, int pixelY, DWORD flags)
     {
         SetCapture(m_hwnd);
 
-        ptMouse = Selection()->ellipse.point;
-        ptMouse.x -= dipX;
-        ptMouse.y -= dipY;
+        Geometry::Point2D point = handles.Position(SelectedIndex());
+        ptMouse.x = (float)point.x - dipX;
+        ptMouse.y = (float)point.y - dipY;
 
         SetMode(DragMode);
     }
@@ -665,7 +767,7 @@ void AlgorithmWindow::OnLButtonDown(int pixelX, int pixelY, DWORD flags)
 void AlgorithmWindow::OnLButtonUp()
 {
     move_ind = 0;
-    if ((mode == DrawMode) && Selection())
+    if ((mode == DrawMode) && HasSelection())
     {
         ClearSelection();
         InvalidateRect(m_hwnd, NULL, FALSE);
@@ -683,72 +785,39 @@ void AlgorithmWindow::OnMouseMove(int pixelX, int pixelY, DWORD flags)
     const float dipX = DPIScale::PixelsToDipsX(pixelX);
     const float dipY = DPIScale::PixelsToDipsY(pixelY);
 
-    if ((flags & MK_LBUTTON) && Selection())
+    if ((flags & MK_LBUTTON) && HasSelection())
     {
         if (mode == DragMode)
         {
             // Move the ellipse.
-            vector<D2D1_ELLIPSE> new_points;
-            Selection()->ellipse.point.x = dipX + ptMouse.x;
-            Selection()->ellipse.point.y = dipY + ptMouse.y;
-
-            for (auto i = ellipses.begin(); i != ellipses.end(); i++) {
-                D2D1_ELLIPSE point1 = D2D1::Ellipse(D2D1::Point2F((*i)->ellipse.point.x, (*i)->ellipse.point.y), 10.0f, 10.0f);
-                new_points.push_back(point1);
-            }
-            if (current_alg == QHull || current_alg == PointHull) {
-                big_points = new_points;
-            }
-            else {
-                small_points = new_points;
+            size_t index = SelectedIndex();
+            D2D1_POINT_2F point = D2D1::Point2F(dipX + ptMouse.x, dipY + ptMouse.y);
+            MoveHandle(index, point);
+
+            // Only the dragged point changes, in place; the hull picks it up on the next paint.
+            vector<D2D1_ELLIPSE>& points = current_alg == QHull || current_alg == PointHull ? big_points : small_points;
+            if (index < points.size()) {
+                points[index].point = point;
             }
+            PointsMoved(index);
+            UpdateHullBounds();
 
         }
         InvalidateRect(m_hwnd, NULL, FALSE);
     }
     else if (flags && MK_LBUTTON && move_ind != 0) {
-        int index = 0;
-        vector<D2D1_ELLIPSE> new_points;
-        switch (move_ind) {
-        case 1:
-            for (auto i = ellipses.begin(); i != ellipses.end(); i++) {
-                if (index < 5) {
-                    (*i)->ellipse.point.x = moving_hull[index].point.x + (dipX - click_pos.x);
-                    (*i)->ellipse.point.y = moving_hull[index].point.y + (dipY - click_pos.y);
-                }
-                D2D1_ELLIPSE point1 = D2D1::Ellipse(D2D1::Point2F((*i)->ellipse.point.x, (*i)->ellipse.point.y), 10.0f, 10.0f);
-                new_points.push_back(point1);
-                index++;
-            }
-            small_points = new_points;
-            break;
-        case 2:
-            for (auto i = ellipses.begin(); i != ellipses.end(); i++) {
-                if (index > 4 && index < 10) {
-                    (*i)->ellipse.point.x = moving_hull[index-5].point.x + (dipX - click_pos.x);
-                    (*i)->ellipse.point.y = moving_hull[index-5].point.y + (dipY - click_pos.y);
-                }
-                D2D1_ELLIPSE point1 = D2D1::Ellipse(D2D1::Point2F((*i)->ellipse.point.x, (*i)->ellipse.point.y), 10.0f, 10.0f);
-                new_points.push_back(point1);
-                index++;
-            }
-            small_points = new_points;
-            break;
-        case 3:
-            for (auto i = ellipses.begin(); i != ellipses.end(); i++) {
-                if (index < 10) {
-                    (*i)->ellipse.point.x = moving_hull[index].point.x + (dipX - click_pos.x);
-                    (*i)->ellipse.point.y = moving_hull[index].point.y + (dipY - click_pos.y);
-                    D2D1_ELLIPSE point1 = D2D1::Ellipse(D2D1::Point2F((*i)->ellipse.point.x, (*i)->ellipse.point.y), 10.0f, 10.0f);
-                    new_points.push_back(point1);
-                }
-                index++;
-            }
-            big_points = new_points;
-            break;
-        default:
-            break;
+        // The hull's points follow the mouse from where they were at the click: 0 to 4 for hull1, 5 to 9 for
+        // hull2 (both in small_points), 0 to 9 of big_points for the point hull.
+        vector<D2D1_ELLIPSE>& points = move_ind == 3 ? big_points : small_points;
+        size_t first = move_ind == 2 ? 5 : 0;
+        size_t count = move_ind == 3 ? 10 : 5;
+        for (size_t i = 0; i < count; i++) {
+            D2D1_POINT_2F point = D2D1::Point2F(moving_hull[i].point.x + (dipX - click_pos.x), moving_hull[i].point.y + (dipY - click_pos.y));
+            points[first + i].point = point;
+            MoveHandle(first + i, point);
         }
+        hull_cache.Touch(move_ind == 1 ? hull1_input : move_ind == 2 ? hull2_input : big_points_input);
+        UpdateHullBounds();
     }
 }
 
@@ -758,9 +827,10 @@ void AlgorithmWindow::OnKeyDown(UINT vkey)
     {
     case VK_BACK:
         /*case VK_DELETE:
-            if (Selection())
+            if (HasSelection())
             {
-                ellipses.erase(selection);
+                handle_picks.Remove(selection.slot);
+                handles.Remove(selection);
                 ClearSelection();
                 SetMode(SelectMode);
                 InvalidateRect(m_hwnd, NULL, FALSE);
@@ -790,13 +860,9 @@ HRESULT AlgorithmWindow::InsertEllipse(float x, float y)
 {
     try
     {
-        selection = ellipses.insert(
-            ellipses.end(),
-            shared_ptr<MyEllipse>(new MyEllipse()));
-
-        Selection()->ellipse.point = ptMouse = D2D1::Point2F(x, y);
-        Selection()->ellipse.radiusX = Selection()->ellipse.radiusY = 10.0f;
-        Selection()->color = D2D1::ColorF(colors[nextColor]);
+        ptMouse = D2D1::Point2F(x, y);
+        selection = handles.Insert(Geometry::Point2D{ x, y }, 10.0, (uint32_t)colors[nextColor]);
+        handle_picks.Insert(selection.slot, Geometry::Point2D{ x, y }, 10.0);
 
         nextColor = (nextColor + 1) % ARRAYSIZE(colors);
     }
@@ -807,25 +873,27 @@ HRESULT AlgorithmWindow::InsertEllipse(float x, float y)
     return S_OK;
 }
 
+// The topmost handle under the point, as a reverse walk over them would find it, but only looking at the
+// ones in the point's cell.
 BOOL AlgorithmWindow::HitTest(float x, float y)
 {
-    for (auto i = ellipses.rbegin(); i != ellipses.rend(); ++i)
+    Geometry::PickIndex::Id hit = handle_picks.Pick(Geometry::Point2D{ x, y });
+    if (hit == Geometry::PickIndex::None)
     {
-        if ((*i)->HitTest(x, y))
-        {
-            selection = (++i).base();
-            return TRUE;
-        }
+        return FALSE;
     }
-    return FALSE;
+    selection = handles.AtSlot(hit);
+    return TRUE;
 }
 
 void AlgorithmWindow::MoveSelection(float x, float y)
 {
-    if (Selection())
+    if (HasSelection())
     {
-        Selection()->ellipse.point.x += x;
-        Selection()->ellipse.point.y += y;
+        size_t index = SelectedIndex();
+        Geometry::Point2D point = handles.Position(index);
+        MoveHandle(index, D2D1::Point2F((float)point.x + x, (float)point.y + y));
+        PointsMoved(index);
         InvalidateRect(m_hwnd, NULL, FALSE);
     }
 }
@@ -0,0 +1,168 @@
+// Streams a binary point file through StreamingHull and reports the throughput.
+//
+//     streamhull generate <file> <points> [square|disc] [seed]
+//     streamhull hull <file> [chunk_points]
+//
+// Point files are Point2D records back to back: x and y as native-endian doubles, 16 bytes a point, no header.
+// generate writes one of the benchmark distributions a million points at a time, so it can make files far
+// bigger than memory, too.
+
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/resource.h>
+#endif
+
+#include "geometry/StreamingHull.h"
+
+using Geometry::Point2D;
+
+namespace {
+
+	const size_t WriteBatch = 1 << 20;
+
+	double Seconds(std::chrono::steady_clock::time_point since) {
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+	}
+
+	// Peak resident set in MB where the OS tells us, -1 elsewhere.
+	double PeakMegabytes() {
+#if defined(__unix__) || defined(__APPLE__)
+		struct rusage usage;
+		if (getrusage(RUSAGE_SELF, &usage) == 0) {
+#if defined(__APPLE__)
+			return usage.ru_maxrss / (1024.0 * 1024.0);
+#else
+			return usage.ru_maxrss / 1024.0;
+#endif
+		}
+#endif
+		return -1;
+	}
+
+	// Plain digits only: strtoull would take "-5" as a huge count and "abc" as 0.
+	bool ParseNumber(const char* text, unsigned long long& value) {
+		char* end = nullptr;
+		value = std::strtoull(text, &end, 10);
+		return std::isdigit((unsigned char)text[0]) && *end == '\0';
+	}
+
+	int Usage() {
+		std::fprintf(stderr, "usage: streamhull generate <file> <points> [square|disc] [seed]\n");
+		std::fprintf(stderr, "       streamhull hull <file> [chunk_points]\n");
+		return 2;
+	}
+
+	int Generate(const char* path, unsigned long long count, bool disc, unsigned seed) {
+		std::FILE* file = std::fopen(path, "wb");
+		if (file == nullptr) {
+			std::fprintf(stderr, "cannot open %s for writing\n", path);
+			return 1;
+		}
+
+		std::mt19937_64 rng(seed);
+		std::uniform_real_distribution<double> unit(0.0, 1.0);
+		std::vector<Point2D> batch;
+		batch.reserve(WriteBatch);
+
+		auto start = std::chrono::steady_clock::now();
+		for (unsigned long long written = 0; written < count;) {
+			size_t n = count - written < WriteBatch ? (size_t)(count - written) : WriteBatch;
+			batch.resize(n);
+			for (size_t i = 0; i < n; i++) {
+				if (disc) {
+					double r = 500.0 * std::sqrt(unit(rng));
+					double theta = 6.283185307179586 * unit(rng);
+					batch[i] = Point2D{ 500.0 + r * std::cos(theta), 500.0 + r * std::sin(theta) };
+				}
+				else {
+					batch[i] = Point2D{ 1000.0 * unit(rng), 1000.0 * unit(rng) };
+				}
+			}
+			if (std::fwrite(batch.data(), sizeof(Point2D), n, file) != n) {
+				std::fprintf(stderr, "write to %s failed\n", path);
+				std::fclose(file);
+				return 1;
+			}
+			written += n;
+		}
+		if (std::fclose(file) != 0) {
+			std::fprintf(stderr, "write to %s failed\n", path);
+			return 1;
+		}
+
+		double seconds = Seconds(start);
+		std::printf("wrote %llu points (%.1f MB) in %.3f s: %.1f Mpoints/s\n", count, count * sizeof(Point2D) / 1e6, seconds, count / seconds / 1e6);
+		return 0;
+	}
+
+	int Hull(const char* path, size_t chunk_points) {
+		Geometry::StreamingHull streaming(chunk_points);
+
+		auto start = std::chrono::steady_clock::now();
+		if (!streaming.AddFile(path)) {
+			std::fprintf(stderr, "cannot read %s (missing, or not a whole number of 16-byte points)\n", path);
+			return 1;
+		}
+		const std::vector<Point2D>& hull = streaming.Hull();
+		double seconds = Seconds(start);
+
+		unsigned long long points = streaming.Points();
+		if (points == 0) {
+			std::fprintf(stderr, "%s has no points\n", path);
+			return 1;
+		}
+		std::printf("points    %llu (%.1f MB)\n", points, points * sizeof(Point2D) / 1e6);
+		std::printf("chunks    %llu of %zu points\n", (unsigned long long)streaming.Chunks(), streaming.ChunkPoints());
+		std::printf("hull      %zu vertices\n", hull.size());
+		std::printf("time      %.3f s\n", seconds);
+		std::printf("rate      %.1f Mpoints/s, %.0f MB/s\n", points / seconds / 1e6, points * sizeof(Point2D) / seconds / 1e6);
+		double peak = PeakMegabytes();
+		if (peak >= 0) {
+			std::printf("peak rss  %.1f MB\n", peak);
+		}
+		return 0;
+	}
+}
+
+int main(int argc, char** argv) {
+	if (argc < 3) {
+		return Usage();
+	}
+
+	if (std::strcmp(argv[1], "generate") == 0 && argc >= 4 && argc <= 6) {
+		unsigned long long count = 0;
+		if (!ParseNumber(argv[3], count) || count == 0) {
+			return Usage();
+		}
+		bool disc = false;
+		if (argc >= 5) {
+			if (std::strcmp(argv[4], "disc") == 0) {
+				disc = true;
+			}
+			else if (std::strcmp(argv[4], "square") != 0) {
+				return Usage();
+			}
+		}
+		unsigned long long seed = 1;
+		if (argc >= 6 && !ParseNumber(argv[5], seed)) {
+			return Usage();
+		}
+		return Generate(argv[2], count, disc, (unsigned)seed);
+	}
+	if (std::strcmp(argv[1], "hull") == 0 && argc <= 4) {
+		unsigned long long chunk_points = Geometry::StreamingHull::DefaultChunkPoints;
+		if (argc >= 4 && (!ParseNumber(argv[3], chunk_points) || chunk_points == 0)) {
+			return Usage();
+		}
+		return Hull(argv[2], (size_t)chunk_points);
+	}
+	return Usage();
+}